@@ -5,6 +5,7 @@
 #include <thread>
 #include <cstdlib>
 #include <algorithm>
+#include <cmath>
 #include "file_utils.hpp" // for game_rules & rule loading
 
 static const char* slotName(int slot) {
@@ -27,6 +28,13 @@ GameEngine::GameEngine(int width, int height)
     for (int i = 0; i < 4; ++i) { _libKeyMap[i] = -1; _libSlotAvailable[i] = false; }
     _defaultLibIndex = -1;
     _lastAppliedFPS = 60;
+    _tickRate = 120;
+    _maxCatchUpTicks = 8;
+    _tickAccumulator = 0.0;
+    _lastRenderedLib = nullptr;
+    _lastRenderedGeneration = 0;
+    _threadedSimulation = false;
+    _recordedGames = 0;
 
     // Initialize menu system with the actual board dimensions from command line
     GameSettings settings = _menuSystem.getSettings();
@@ -94,15 +102,18 @@ int GameEngine::initialize(int preferredLibraryIndex) {
         return 1;
     }
 
+    auto startupBegin = std::chrono::steady_clock::now();
+
+    // Switch to preferred slot via mapping (0..3). Fallback to default if missing.
+    int targetSlot = preferredLibraryIndex;
+    if (targetSlot < 0 || targetSlot > 3) targetSlot = 0;
+
     // Load graphics libraries
-    if (loadDefaultLibraries() != 0) {
+    if (loadDefaultLibraries(targetSlot) != 0) {
         setError("Failed to load graphics libraries");
         return 1;
     }
 
-    // Switch to preferred slot via mapping (0..3). Fallback to default if missing.
-    int targetSlot = preferredLibraryIndex;
-    if (targetSlot < 0 || targetSlot > 3) targetSlot = 0;
     int actualIndex = (targetSlot >= 0 && targetSlot <= 3) ? _libKeyMap[targetSlot] : -1;
     if (actualIndex < 0) actualIndex = _defaultLibIndex;
 
@@ -131,6 +142,21 @@ int GameEngine::initialize(int preferredLibraryIndex) {
 
     // Set frame rate to 60 FPS
     currentLib->setFrameRate(60);
+    applyVsync(_libraryManager.getCurrentLibraryIndex(), _lastAppliedFPS > 0);
+    logCapabilities(_libraryManager.getCurrentLibraryIndex());
+
+    int loadedCount = 0;
+    int deferredCount = 0;
+    for (size_t i = 0; i < _libraryManager.getLibraryCount(); ++i) {
+        if (_libraryManager.isLibraryLoaded(static_cast<int>(i)))
+            ++loadedCount;
+        else if (_libraryManager.isLibraryUsable(static_cast<int>(i)))
+            ++deferredCount;
+    }
+    double startupMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - startupBegin).count();
+    std::cout << "Graphics ready in " << startupMs << " ms (" << loadedCount << " loaded, "
+              << deferredCount << " deferred until first switch)" << std::endl;
 
     _initialized = true;
     return 0;
@@ -154,13 +180,63 @@ void GameEngine::run() {
 
     // Start the game loop
     gameLoop();
+    _simThread.stop();
+    stopRecording();
 
-    // Cleanup
-    // Re-acquire the current library in case it changed during the game
-    currentLib = _libraryManager.getCurrentLibrary();
-    if (currentLib) {
-        currentLib->shutdown();
+    // Cleanup, including libraries left suspended by a switch
+    shutdownLibraries();
+}
+
+void GameEngine::setRecordPath(const std::string& path) {
+    _recordPath = path;
+}
+
+int GameEngine::runReplay(const char* path) {
+    if (!_initialized) {
+        setError("Game engine not initialized");
+        return 1;
+    }
+    replay_log log;
+    if (replay_load(path, log) != 0) {
+        setError(std::string("Failed to load replay log '") + (path ? path : "") + "'");
+        return 1;
+    }
+    replay_player player(log);
+    if (player.start(_gameData) != 0) {
+        setError("Replay log describes an invalid board");
+        return 1;
+    }
+    IGraphicsLibrary* currentLib = _libraryManager.getCurrentLibrary();
+    if (currentLib)
+        currentLib->setMenuSystem(&_menuSystem);
+    _menuSystem.setState(MenuState::IN_GAME);
+
+    // No frame limiting: every recorded tick is rendered as soon as it runs
+    applyVsync(_libraryManager.getCurrentLibraryIndex(), false);
+    auto start = std::chrono::steady_clock::now();
+    bool gameOver = false;
+    int result = 0;
+    while ((result = player.step(_gameData)) != 2) {
+        if (result == 1)
+            gameOver = true;
+        currentLib = _libraryManager.getCurrentLibrary();
+        if (!currentLib)
+            break;
+        GameKey key = currentLib->getInput();
+        if (key == GameKey::ESCAPE || key == GameKey::QUIT || !currentLib->shouldContinue())
+            break;
+        renderGame();
     }
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    shutdownLibraries();
+
+    std::cout << "Replayed " << player.get_tick() << " ticks in " << elapsed << " s" << std::endl;
+    if (gameOver)
+        std::cout << "Recorded game ended in a collision" << std::endl;
+    if (player.finished())
+        std::cout << (player.desynced() ? "Final board DIFFERS from the recording"
+                                        : "Final board matches the recording") << std::endl;
+    return (player.finished() && player.desynced()) ? 1 : 0;
 }
 
 const char* GameEngine::getError() const {
@@ -173,14 +249,11 @@ bool GameEngine::isInitialized() const {
 
 void GameEngine::gameLoop() {
     bool shouldQuit = false;
-    // Fixed render FPS for smoothness
-    int currentFPS = 60;
-    auto frameDuration = std::chrono::microseconds(1000000 / currentFPS);
-    auto lastFrameTime = std::chrono::steady_clock::now();
+    _lastUpdateTime = std::chrono::steady_clock::now();
     while (!shouldQuit) {
         auto frameStart = std::chrono::steady_clock::now();
-        double deltaTime = std::chrono::duration<double>(frameStart - lastFrameTime).count();
-        lastFrameTime = frameStart;
+        double deltaTime = std::chrono::duration<double>(frameStart - _lastUpdateTime).count();
+        _lastUpdateTime = frameStart;
 
         IGraphicsLibrary* currentLib = _libraryManager.getCurrentLibrary();
         if (!currentLib) {
@@ -188,22 +261,16 @@ void GameEngine::gameLoop() {
             break;
         }
 
-        // Handle input
-        GameKey key = GameKey::NONE;
+        // Handle every key that arrived since the last frame
+        bool inputReceived = false;
         try {
-            key = currentLib->getInput();
+            inputReceived = pumpInput(shouldQuit);
         } catch (...) {
             print_error("Error: Graphics library crashed during input handling");
             shouldQuit = true;
             break;
         }
 
-        // Only process input if we actually got a key
-        bool inputReceived = (key != GameKey::NONE);
-        if (inputReceived) {
-            handleInput(key, shouldQuit);
-        }
-
         // IMPORTANT: The input handler may have switched libraries.
         // Refresh the currentLib pointer to avoid using a stale (possibly destroyed) instance.
         currentLib = _libraryManager.getCurrentLibrary();
@@ -276,13 +343,92 @@ void GameEngine::gameLoop() {
             shouldQuit = true;
         }
 
-        // Frame rate limiting
-        auto frameEnd = std::chrono::steady_clock::now();
-        auto elapsed = frameEnd - frameStart;
-        if (elapsed < frameDuration) {
-            std::this_thread::sleep_for(frameDuration - elapsed);
+        // Frame rate limiting; the simulation does not depend on it
+        if (_lastAppliedFPS > 0 && !shouldQuit) {
+            auto frameEnd = frameStart + std::chrono::microseconds(1000000 / _lastAppliedFPS);
+            if (waitForFrameEnd(frameEnd, shouldQuit) != 0) {
+                shouldQuit = true;
+            }
+        }
+    }
+}
+
+// Handles every pending key; returns true when at least one arrived
+bool GameEngine::pumpInput(bool& shouldQuit) {
+    IGraphicsLibrary* currentLib = _libraryManager.getCurrentLibrary();
+    if (!currentLib)
+        return false;
+    InputEvent events[INPUT_BATCH_SIZE];
+    int count = _libraryManager.hasCurrentInterface(_libraryManager.getCurrentLibraryIndex())
+                    ? currentLib->pollInputEvents(events, INPUT_BATCH_SIZE)
+                    : currentLib->pollGetInput(events, INPUT_BATCH_SIZE);
+    for (int i = 0; i < count && !shouldQuit; ++i) {
+        handleInput(events[i].key, shouldQuit);
+        // Keys read by a library that was just switched away are dropped
+        if (_libraryManager.getCurrentLibrary() != currentLib)
+            break;
+    }
+    return count > 0;
+}
+
+// When the main-thread simulation has its next tick due. The time is
+// fixed by the last update and the banked time, so polling it again as
+// keys arrive does not push it back. Returns false when not ticking.
+bool GameEngine::nextTickTime(std::chrono::steady_clock::time_point& tickAt) const {
+    if (!_gameStarted || _simThread.isRunning() || _menuSystem.getCurrentState() != MenuState::IN_GAME)
+        return false;
+    double speedMultiplier = std::max(0.1, _menuSystem.getSettings().speedMultiplier);
+    double remaining = std::max(0.0, (1.0 / _tickRate - _tickAccumulator) / speedMultiplier);
+    tickAt = _lastUpdateTime + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                   std::chrono::duration<double>(remaining));
+    return true;
+}
+
+// Spends the rest of the frame waiting on input instead of sleeping, so
+// keys are handled as they arrive and ticks run on time between renders.
+// Returns 1 when the graphics library failed.
+int GameEngine::waitForFrameEnd(std::chrono::steady_clock::time_point frameEnd, bool& shouldQuit) {
+    IGraphicsLibrary* frameLib = _libraryManager.getCurrentLibrary();
+    bool canWait = _libraryManager.hasCurrentInterface(_libraryManager.getCurrentLibraryIndex());
+    while (!shouldQuit) {
+        IGraphicsLibrary* currentLib = _libraryManager.getCurrentLibrary();
+        if (!currentLib || currentLib != frameLib)
+            return 0;
+        auto now = std::chrono::steady_clock::now();
+        if (now >= frameEnd)
+            return 0;
+        auto deadline = frameEnd;
+        std::chrono::steady_clock::time_point tickAt;
+        bool tickFirst = false;
+        if (nextTickTime(tickAt) && tickAt < deadline) {
+            deadline = tickAt;
+            tickFirst = true;
+        }
+
+        int waitMs = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now).count());
+        int waited = -1;
+        try {
+            if (waitMs > 0 && canWait)
+                waited = currentLib->waitForInput(waitMs);
+            if (waited > 0)
+                pumpInput(shouldQuit);
+        } catch (...) {
+            print_error("Error: Graphics library crashed during input handling");
+            return 1;
+        }
+        // Libraries that cannot wait, and millisecond timeouts that return
+        // a little early, sleep out the remainder
+        if (waited <= 0)
+            std::this_thread::sleep_until(deadline);
+
+        if (tickFirst && std::chrono::steady_clock::now() >= deadline) {
+            auto tickTime = std::chrono::steady_clock::now();
+            double deltaTime = std::chrono::duration<double>(tickTime - _lastUpdateTime).count();
+            _lastUpdateTime = tickTime;
+            updateGame(shouldQuit, deltaTime);
         }
     }
+    return 0;
 }
 
 void GameEngine::handleInput(GameKey key, bool& shouldQuit) {
@@ -309,38 +455,24 @@ void GameEngine::handleInput(GameKey key, bool& shouldQuit) {
         // Handle game input
         switch (key) {
         case GameKey::UP:
-            _gameData.set_direction_moving(0, DIRECTION_UP);
-            if (!_gameStarted) {
-                _gameStarted = true;
-                std::cout << "Game Started! Use arrow keys to control the snake." << std::endl;
-            }
+            steerSnake(DIRECTION_UP);
             break;
         case GameKey::DOWN:
-            _gameData.set_direction_moving(0, DIRECTION_DOWN);
-            if (!_gameStarted) {
-                _gameStarted = true;
-                std::cout << "Game Started! Use arrow keys to control the snake." << std::endl;
-            }
+            steerSnake(DIRECTION_DOWN);
             break;
         case GameKey::LEFT:
-            _gameData.set_direction_moving(0, DIRECTION_LEFT);
-            if (!_gameStarted) {
-                _gameStarted = true;
-                std::cout << "Game Started! Use arrow keys to control the snake." << std::endl;
-            }
+            steerSnake(DIRECTION_LEFT);
             break;
         case GameKey::RIGHT:
-            _gameData.set_direction_moving(0, DIRECTION_RIGHT);
-            if (!_gameStarted) {
-                _gameStarted = true;
-                std::cout << "Game Started! Use arrow keys to control the snake." << std::endl;
-            }
+            steerSnake(DIRECTION_RIGHT);
             break;
         case GameKey::ESCAPE:
         case GameKey::QUIT:
             // Go back to main menu instead of quitting directly
             _menuSystem.setState(MenuState::MAIN_MENU);
             _gameStarted = false;
+            _simThread.stop();
+            stopRecording();
             prepareBoardForNextGame();
             break;
         case GameKey::NONE:
@@ -357,22 +489,160 @@ void GameEngine::handleInput(GameKey key, bool& shouldQuit) {
     }
 }
 
+void GameEngine::steerSnake(int direction) {
+    if (!_gameStarted) {
+        _gameStarted = true;
+        if (!_recordPath.empty()) {
+            _recordFile = replay_game_path(_recordPath, ++_recordedGames);
+            if (_recorder.begin(_gameData, _recordFile.c_str()) != 0)
+                print_warning("Could not open replay log '" + _recordFile + "' for writing");
+        }
+        std::cout << "Game Started! Use arrow keys to control the snake." << std::endl;
+    }
+    if (_simThread.isRunning()) {
+        // A full queue only happens if the simulation thread stalled; the
+        // turn is dropped like a key press between two ticks would be
+        _simThread.pushDirection(0, direction);
+        return;
+    }
+    _gameData.queue_direction(0, direction);
+    _recorder.record_turn(0, direction);
+    if (_threadedSimulation)
+        startSimulationThread();
+}
+
+void GameEngine::startSimulationThread() {
+    // Libraries that still read the board directly need it on this thread
+    int currentIndex = _libraryManager.getCurrentLibraryIndex();
+    if (!(_libraryManager.getCapabilities(currentIndex).flags & GRAPHICS_CAP_SNAPSHOT_RENDER))
+        return;
+    double speedMultiplier = std::max(0.1, _menuSystem.getSettings().speedMultiplier);
+    if (_simThread.start(_gameData, _recorder, _tickRate, _maxCatchUpTicks, speedMultiplier) != 0) {
+        print_warning("Could not start the simulation thread; ticking on the main thread");
+        _threadedSimulation = false;
+    }
+}
+
+void GameEngine::stopRecording() {
+    if (!_recorder.is_recording())
+        return;
+    if (_recorder.end(_gameData) != 0)
+        print_warning("Failed to finish replay log '" + _recordFile + "'");
+    else
+        std::cout << "Replay saved to " << _recordFile << std::endl;
+}
+
 void GameEngine::updateGame(bool& /* shouldQuit */, double deltaTime) {
     // Only update game logic if the game has started
     if (!_gameStarted) {
+        _tickAccumulator = 0.0;
+        return;
+    }
+    if (_simThread.isRunning()) {
+        // Ticks run on the simulation thread; only collect its game over
+        if (_simThread.isGameOver()) {
+            _simThread.stop();
+            stopRecording();
+            handleGameOver();
+        }
         return;
     }
 
-    // Update game logic based on elapsed time
+    // Wall-clock time is banked and spent in fixed ticks, so the simulation
+    // sees the same step sizes whatever the render rate.
     // Scale movement speed based on settings (baseline multiplier: 1.0)
     double speedMultiplier = std::max(0.1, _menuSystem.getSettings().speedMultiplier);
-    double scaledDelta = deltaTime * speedMultiplier;
-    int updateResult = _gameData.update_game_map(scaledDelta);
-    if (updateResult != 0) {
-        handleGameOver();
+    const double tickLength = 1.0 / _tickRate;
+    _tickAccumulator += deltaTime * speedMultiplier;
+    int ticksRun = 0;
+    while (_tickAccumulator >= tickLength) {
+        if (ticksRun >= _maxCatchUpTicks) {
+            // After a long stall drop the backlog instead of replaying it all
+            _tickAccumulator = std::fmod(_tickAccumulator, tickLength);
+            break;
+        }
+        _tickAccumulator -= tickLength;
+        ++ticksRun;
+        _recorder.record_step(tickLength);
+        if (_gameData.update_game_map(tickLength) != 0) {
+            _tickAccumulator = 0.0;
+            stopRecording();
+            handleGameOver();
+            return;
+        }
     }
 }
 
+void GameEngine::setTickRate(int ticksPerSecond) {
+    if (ticksPerSecond > 0)
+        _tickRate = ticksPerSecond;
+}
+
+void GameEngine::setMaxCatchUpTicks(int ticks) {
+    if (ticks > 0)
+        _maxCatchUpTicks = ticks;
+}
+
+void GameEngine::setThreadedSimulation(bool enabled) {
+    _threadedSimulation = enabled;
+}
+
+void GameEngine::setRenderFrameRate(int fps) {
+    if (fps < 0)
+        return;
+    _lastAppliedFPS = fps;
+    IGraphicsLibrary* currentLib = _libraryManager.getCurrentLibrary();
+    if (currentLib && fps > 0)
+        currentLib->setFrameRate(fps);
+    // An uncapped frame rate should not be held back by the display either
+    applyVsync(_libraryManager.getCurrentLibraryIndex(), fps > 0);
+}
+
+void GameEngine::applyVsync(int libraryIndex, bool enabled) {
+    IGraphicsLibrary* lib = _libraryManager.getLibrary(libraryIndex);
+    if (lib && (_libraryManager.getCapabilities(libraryIndex).flags & GRAPHICS_CAP_VSYNC_CONTROL))
+        lib->setVsync(enabled);
+}
+
+void GameEngine::logCapabilities(int libraryIndex) const {
+    const GraphicsCapabilities& caps = _libraryManager.getCapabilities(libraryIndex);
+    const char* name = _libraryManager.getLibraryName(libraryIndex);
+    std::string description;
+    if (caps.abiVersion == 0) {
+        description = "legacy plugin, drawn from the board";
+    } else {
+        static const struct { uint32_t flag; const char* label; } labels[] = {
+            {GRAPHICS_CAP_SNAPSHOT_RENDER, "snapshot"},
+            {GRAPHICS_CAP_INCREMENTAL_RENDER, "incremental"},
+            {GRAPHICS_CAP_VSYNC_CONTROL, "vsync"},
+            {GRAPHICS_CAP_THREADED_RENDER, "threaded"},
+            {GRAPHICS_CAP_TERMINAL, "terminal"}
+        };
+        for (const auto& label : labels) {
+            if (caps.flags & label.flag)
+                description += std::string(description.empty() ? "" : ", ") + label.label;
+        }
+        if (description.empty())
+            description = "no optional features";
+        if (caps.maxBoardWidth > 0 && caps.maxBoardHeight > 0)
+            description += "; boards up to " + std::to_string(caps.maxBoardWidth) + "x" +
+                           std::to_string(caps.maxBoardHeight);
+        if (caps.preferredTileSize > 0)
+            description += "; " + std::to_string(caps.preferredTileSize) + " px tiles";
+    }
+    std::cout << (name ? name : "Unknown Library") << ": " << description << std::endl;
+}
+
+// Whether the library can draw the current board, from its declared limit
+bool GameEngine::libraryFitsBoard(int libraryIndex) const {
+    const GraphicsCapabilities& caps = _libraryManager.getCapabilities(libraryIndex);
+    if (caps.maxBoardWidth > 0 && static_cast<int>(_gameData.get_width()) > caps.maxBoardWidth)
+        return false;
+    if (caps.maxBoardHeight > 0 && static_cast<int>(_gameData.get_height()) > caps.maxBoardHeight)
+        return false;
+    return true;
+}
+
 void GameEngine::handleGameOver() {
     int finalScore = _gameData.get_snake_length(0);
     std::cout << "Game Over! Snake collided. Final length: " << finalScore << std::endl;
@@ -422,12 +692,59 @@ void GameEngine::prepareBoardForNextGame() {
 }
 void GameEngine::renderGame() {
     IGraphicsLibrary* currentLib = _libraryManager.getCurrentLibrary();
-    if (currentLib) {
+    if (!currentLib)
+        return;
+
+    int currentIndex = _libraryManager.getCurrentLibraryIndex();
+    const GraphicsCapabilities& caps = _libraryManager.getCapabilities(currentIndex);
+    if (!_libraryManager.hasCurrentInterface(currentIndex) ||
+        (!(caps.flags & GRAPHICS_CAP_SNAPSHOT_RENDER) && !_simThread.isRunning())) {
+        // Older plugins draw straight from the board; building a snapshot
+        // they would only forward to render(const game_data&) is wasted work.
+        // Plugins predating the snapshot overload have no slot for it, and
+        // activateLibrary() never leaves the simulation thread under them.
+        _gameData.acknowledge_dirty_cells();
+        _lastRenderedLib = currentLib;
+        _lastRenderedGeneration = 0;
+        _renderSnapshot.source = nullptr;
         currentLib->render(_gameData);
+        return;
+    }
+
+    RenderSnapshot* snapshot = &_renderSnapshot;
+    bool fresh = true;
+    if (_simThread.isRunning()) {
+        fresh = _simThread.acquireSnapshot();
+        snapshot = &_simThread.snapshot();
+    } else if (!_renderSnapshot.source || _renderSnapshot.generation != _gameData.get_board_generation()) {
+        // Rebuilt only when the board moved on since the last frame
+        _gameData.build_render_snapshot(_renderSnapshot);
+        _gameData.acknowledge_dirty_cells();
+    } else {
+        fresh = false;
     }
+    if (!fresh) {
+        // Same board as the last frame: nothing to patch
+        snapshot->baseGeneration = snapshot->generation;
+        snapshot->dirtyCells.clear();
+        snapshot->fullRedraw = false;
+    }
+    // Time banked since the last tick still advances the snakes' phase
+    if (!_simThread.isRunning())
+        _gameData.fill_move_phase(_renderSnapshot, _tickAccumulator);
+    // A library that did not draw the previous frame has no copy of the
+    // board to patch, and neither does one that missed a snapshot.
+    if (currentLib != _lastRenderedLib || snapshot->baseGeneration != _lastRenderedGeneration ||
+        !(caps.flags & GRAPHICS_CAP_INCREMENTAL_RENDER)) {
+        snapshot->fullRedraw = true;
+        snapshot->dirtyCells.clear();
+    }
+    _lastRenderedLib = currentLib;
+    currentLib->render(*snapshot);
+    _lastRenderedGeneration = snapshot->generation;
 }
 
-int GameEngine::loadDefaultLibraries() {
+int GameEngine::loadDefaultLibraries(int preferredSlot) {
     // Table of intended slots and their library paths
     struct Entry { int slot; const char* path; } entries[] = {
         {0, "./dllibs/lib_ncurses.so"},
@@ -436,29 +753,51 @@ int GameEngine::loadDefaultLibraries() {
         {3, "./dllibs/lib_raylib.so"}
     };
 
+    // Nothing is opened yet; only the preferred slot is dlopened at
+    // startup, the others on their first switch
     for (const auto& e : entries) {
-        if (_libraryManager.loadLibrary(e.path) != 0) {
-            // Mark missing and report error for this specific library
-            _libKeyMap[e.slot] = -1;
-            std::string err = std::string("Failed to load ") + slotName(e.slot) + ": " + _libraryManager.getError();
-            print_error(err);
+        _libKeyMap[e.slot] = _libraryManager.registerLibrary(e.path, slotName(e.slot));
+    }
+
+    // Check the other plugins in the background while the preferred one
+    // pulls in its dependencies
+    _libraryManager.startProbe();
+
+    bool reported[4] = {false, false, false, false};
+    for (int attempt = -1; attempt < 4 && _defaultLibIndex < 0; ++attempt) {
+        int slot = (attempt < 0) ? preferredSlot : attempt;
+        if (_libKeyMap[slot] < 0 || reported[slot])
+            continue;
+        if (_libraryManager.ensureLoaded(_libKeyMap[slot]) == 0) {
+            _defaultLibIndex = _libKeyMap[slot];
         } else {
-            // New library appended at the end
-            size_t countAfter = _libraryManager.getLibraryCount();
-            int newIndex = static_cast<int>(countAfter - 1);
-            _libKeyMap[e.slot] = newIndex;
-            _libSlotAvailable[e.slot] = true;
-            if (_defaultLibIndex < 0) {
-                _defaultLibIndex = newIndex;
-            }
+            std::string err = std::string("Failed to load ") + slotName(slot) + ": " + _libraryManager.getError();
+            print_error(err);
+            reported[slot] = true;
         }
     }
 
-    if (_libraryManager.getLibraryCount() == 0) {
+    _libraryManager.finishProbe();
+
+    if (_defaultLibIndex < 0) {
         setError("No graphics libraries could be loaded");
         return 1;
     }
 
+    for (int slot = 0; slot < 4; ++slot) {
+        int index = _libKeyMap[slot];
+        if (index >= 0 && _libraryManager.isLibraryUsable(index)) {
+            _libSlotAvailable[slot] = true;
+            continue;
+        }
+        if (index >= 0 && !reported[slot]) {
+            std::string err = std::string("Failed to load ") + slotName(slot) + ": " +
+                              _libraryManager.getLibraryError(index);
+            print_error(err);
+        }
+        _libKeyMap[slot] = -1;
+    }
+
     // For each missing slot, map to default and warn user
     for (int slot = 0; slot < 4; ++slot) {
         if (_libKeyMap[slot] < 0) {
@@ -475,6 +814,7 @@ int GameEngine::loadDefaultLibraries() {
 }
 
 void GameEngine::switchGraphicsLibrary(int librarySlot) {
+    auto switchStart = std::chrono::steady_clock::now();
     IGraphicsLibrary* currentLib = _libraryManager.getCurrentLibrary();
     int previousIndex = _libraryManager.getCurrentLibraryIndex();
 
@@ -507,149 +847,150 @@ void GameEngine::switchGraphicsLibrary(int librarySlot) {
         std::cout << remapMessage << std::endl;
     }
 
-    // Shutdown current library
-    if (currentLib) {
-        currentLib->shutdown();
-
-        // Small delay to ensure clean shutdown
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
-        std::this_thread::yield();
+    bool firstLoad = !_libraryManager.isLibraryLoaded(actualIndex);
+    // Loading is cheap next to initializing, and the capabilities decide
+    // whether the switch can happen at all
+    if (_libraryManager.ensureLoaded(actualIndex) == 0) {
+        if (firstLoad)
+            logCapabilities(actualIndex);
+        if (!libraryFitsBoard(actualIndex)) {
+            const GraphicsCapabilities& caps = _libraryManager.getCapabilities(actualIndex);
+            std::string message = std::string(_libraryManager.getLibraryName(actualIndex)) + " supports boards up to " +
+                                  std::to_string(caps.maxBoardWidth) + "x" + std::to_string(caps.maxBoardHeight);
+            std::cout << message << std::endl;
+            if (currentLib)
+                currentLib->setSwitchMessage(message, 180);
+            return;
+        }
     }
 
-    std::string failureReason;
+    // Keep the current library warm in the background when it can be
+    if (currentLib) {
+        deactivateLibrary(previousIndex);
+    }
 
-    // Switch to new library
-    if (_libraryManager.switchToLibrary(actualIndex) == 0) {
+    bool warm = false;
+    if (activateLibrary(actualIndex, warm) == 0) {
         IGraphicsLibrary* newLib = _libraryManager.getCurrentLibrary();
-        if (newLib) {
-            // Try to initialize the new library
-            int initResult = newLib->initialize();
-
-            if (initResult == 0) {
-                newLib->setFrameRate(60);
-
-                // Set up menu system for the new library
-                newLib->setMenuSystem(&_menuSystem);
-
-                // Special handling for different libraries
-                const char* newLibName = _libraryManager.getLibraryName(actualIndex);
-                if (newLibName && std::string(newLibName) == "NCurses") {
-                    // Try to bring terminal to front on macOS
-                    std::system("osascript -e 'tell application \"Terminal\" to activate' 2>/dev/null || true");
-
-                    // Additional delay to ensure focus transfer
-                    std::this_thread::sleep_for(std::chrono::milliseconds(100));
-
-                    // Force NCurses to be ready for input
-                    // This will be handled by the forceInputReadiness() method called in initialize()
-                } else if (newLibName && (std::string(newLibName).find("Raylib") != std::string::npos ||
-                                        std::string(newLibName).find("OpenGL") != std::string::npos)) {
-                    // Small delay for OpenGL-based libraries to ensure context is ready
-                    std::this_thread::sleep_for(std::chrono::milliseconds(50));
-                }
-
-                if (remapped && !remapMessage.empty()) {
-                    newLib->setSwitchMessage(remapMessage, 180);
-                } else {
-                    std::string message = std::string("Switched to: ") + (newLibName ? newLibName : "Unknown Library");
-                    newLib->setSwitchMessage(message, 120); // Show for 2 seconds at 60 FPS
-                }
-            } else {
-                std::string errorMsg = "Failed to initialize new graphics library: ";
-                errorMsg += (newLib->getError() ? newLib->getError() : "Unknown error");
-                std::cerr << errorMsg << std::endl;
-
-                // Switch back to the previous library
-                const char* previousLibName = _libraryManager.getLibraryName(previousIndex);
-                if (previousIndex >= 0 && _libraryManager.switchToLibrary(previousIndex) == 0) {
-                    IGraphicsLibrary* restoredLib = _libraryManager.getCurrentLibrary();
-                    if (restoredLib && restoredLib->initialize() == 0) {
-                        restoredLib->setFrameRate(60);
-                        restoredLib->setMenuSystem(&_menuSystem);
-                        std::string restoredMessage = std::string("Restored previous graphics library: ") +
-                                                        (previousLibName ? previousLibName : "Unknown");
-                        restoredMessage += ". Reason: " + errorMsg;
-                        restoredLib->setSwitchMessage(restoredMessage, 120);
-                    } else if (restoredLib) {
-                        std::string failureMessage = std::string("Failed to reinitialize previous graphics library: ") +
-                                                     (previousLibName ? previousLibName : "Unknown");
-                        failureMessage += ". Reason: " + errorMsg;
-                        restoredLib->setSwitchMessage(failureMessage, 180);
-                    }
-                } else if (newLib) {
-                    // If we can't restore, show error in the failed new library
-                    std::string failureMessage = std::string("Failed to restore previous graphics library: ") +
-                                                 (previousLibName ? previousLibName : "Unknown");
-                    failureMessage += ". Reason: " + errorMsg;
-                    newLib->setSwitchMessage(failureMessage, 180);
-                }
-            }
+        // The name changes once a deferred library is loaded
+        targetLibName = _libraryManager.getLibraryName(actualIndex);
+        double latencyMs = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - switchStart).count();
+        std::cout << "Switched to " << (targetLibName ? targetLibName : "Unknown Library") << " in "
+                  << latencyMs << " ms ("
+                  << (warm ? "resumed" : (firstLoad ? "loaded and initialized" : "initialized")) << ")" << std::endl;
+        if (remapped && !remapMessage.empty()) {
+            newLib->setSwitchMessage(remapMessage, 180);
         } else {
-            // Couldn't get the new library instance; restore previous library immediately
-            failureReason = "Failed to get new graphics library instance";
-            std::cerr << failureReason << std::endl;
-            if (previousIndex >= 0 && _libraryManager.switchToLibrary(previousIndex) == 0) {
-                IGraphicsLibrary* restoredLib = _libraryManager.getCurrentLibrary();
-                if (restoredLib && restoredLib->initialize() == 0) {
-                    restoredLib->setFrameRate(60);
-                    restoredLib->setMenuSystem(&_menuSystem);
-                    std::string restoredMessage = std::string("Restored previous graphics library: ") +
-                                                    (currentLibName ? currentLibName : "Unknown");
-                    if (!failureReason.empty()) {
-                        restoredMessage += ". Reason: " + failureReason;
-                    }
-                    restoredLib->setSwitchMessage(restoredMessage, 180);
-                } else if (restoredLib) {
-                    std::string failureMessage = std::string("Failed to reinitialize previous graphics library: ") +
-                                                 (currentLibName ? currentLibName : "Unknown");
-                    if (!failureReason.empty()) {
-                        failureMessage += ". Reason: " + failureReason;
-                    }
-                    restoredLib->setSwitchMessage(failureMessage, 180);
-                }
-            } else if (currentLib) {
-                if (currentLib->initialize() == 0) {
-                    currentLib->setFrameRate(60);
-                    currentLib->setMenuSystem(&_menuSystem);
-                    std::string restoredMessage = std::string("Restored previous graphics library: ") +
-                                                  (currentLibName ? currentLibName : "Unknown");
-                    if (!failureReason.empty()) {
-                        restoredMessage += ". Reason: " + failureReason;
-                    }
-                    currentLib->setSwitchMessage(restoredMessage, 180);
-                } else {
-                    std::string message = failureReason.empty() ?
-                                            "Failed to switch graphics library" :
-                                            failureReason;
-                    currentLib->setSwitchMessage(message, 180);
-                }
-            }
+            std::string message = std::string("Switched to: ") + (targetLibName ? targetLibName : "Unknown Library") +
+                                  " (" + std::to_string(static_cast<int>(std::lround(latencyMs))) + " ms)";
+            newLib->setSwitchMessage(message, 120); // Show for 2 seconds at 60 FPS
         }
-    } else {
+        return;
+    }
+
+    std::string failureReason;
+    IGraphicsLibrary* failedLib = _libraryManager.getLibrary(actualIndex);
+    if (!failedLib) {
         failureReason = _libraryManager.getError() ? _libraryManager.getError() : "Unknown error";
-        if (!failureReason.empty()) {
-            std::cerr << "Failed to switch graphics library: " << failureReason << std::endl;
+    } else {
+        failureReason = std::string("Failed to initialize new graphics library: ") +
+                        (failedLib->getError() ? failedLib->getError() : "Unknown error");
+    }
+    std::cerr << "Failed to switch graphics library: " << failureReason << std::endl;
+
+    // A plugin that failed to load will not load later either
+    if (!_libraryManager.isLibraryUsable(actualIndex) && librarySlot >= 0 && librarySlot < 4 &&
+        actualIndex != _defaultLibIndex) {
+        _libKeyMap[librarySlot] = _defaultLibIndex;
+        _libSlotAvailable[librarySlot] = false;
+    }
+
+    // Bring the previous library back so the renderer remains usable
+    bool restoredWarm = false;
+    if (previousIndex >= 0 && activateLibrary(previousIndex, restoredWarm) == 0) {
+        std::string restoredMessage = std::string("Restored previous graphics library: ") +
+                                      (currentLibName ? currentLibName : "Unknown");
+        restoredMessage += ". Reason: " + failureReason;
+        _libraryManager.getCurrentLibrary()->setSwitchMessage(restoredMessage, 180);
+    } else if (currentLib) {
+        std::string failureMessage = std::string("Failed to reinitialize previous graphics library: ") +
+                                     (currentLibName ? currentLibName : "Unknown");
+        failureMessage += ". Reason: " + failureReason;
+        currentLib->setSwitchMessage(failureMessage, 180);
+    }
+}
+
+void GameEngine::deactivateLibrary(int libraryIndex) {
+    IGraphicsLibrary* lib = _libraryManager.getLibrary(libraryIndex);
+    if (!lib) {
+        return;
+    }
+    if (_libraryManager.hasCurrentInterface(libraryIndex) && lib->suspend()) {
+        _libraryManager.setLibrarySuspended(libraryIndex, true);
+    } else {
+        lib->shutdown();
+    }
+}
+
+int GameEngine::activateLibrary(int libraryIndex, bool& warm) {
+    warm = false;
+    if (_libraryManager.switchToLibrary(libraryIndex) != 0) {
+        return 1;
+    }
+    IGraphicsLibrary* lib = _libraryManager.getCurrentLibrary();
+    if (!lib) {
+        return 1;
+    }
+
+    if (_libraryManager.isLibrarySuspended(libraryIndex)) {
+        _libraryManager.setLibrarySuspended(libraryIndex, false);
+        if (lib->resume() == 0) {
+            warm = true;
+        } else {
+            lib->shutdown();
         }
-        // Show error in current library if switching failed
-        if (currentLib) {
-            std::string message = std::string("Failed to switch to library: ") + failureReason;
-            currentLib->setSwitchMessage(message, 180);
-
-            // Reinitialize the previous library so the renderer remains usable
-            if (currentLib->initialize() == 0) {
-                currentLib->setFrameRate(60);
-                currentLib->setMenuSystem(&_menuSystem);
-                std::string restoreMessage = std::string("Restored previous graphics library: ") +
-                                             (currentLibName ? currentLibName : "Unknown");
-                if (!failureReason.empty()) {
-                    restoreMessage += ". Reason: " + failureReason;
-                }
-                currentLib->setSwitchMessage(restoreMessage, 180);
-            } else {
-                std::string failureMessage = std::string("Failed to reinitialize previous graphics library: ") +
-                                             (currentLibName ? currentLibName : "Unknown");
-                currentLib->setSwitchMessage(failureMessage, 180);
-            }
+    }
+    if (!warm && lib->initialize() != 0) {
+        return 1;
+    }
+
+    lib->setFrameRate(60);
+    lib->setMenuSystem(&_menuSystem);
+    applyVsync(libraryIndex, _lastAppliedFPS > 0);
+
+    const GraphicsCapabilities& caps = _libraryManager.getCapabilities(libraryIndex);
+    if (!(caps.flags & GRAPHICS_CAP_SNAPSHOT_RENDER) && _simThread.isRunning()) {
+        // The game carries on with main-thread ticks; steering restarts
+        // the thread after switching back to a snapshot library
+        _simThread.stop();
+        _tickAccumulator = 0.0;
+    }
+
+#ifdef __APPLE__
+    // Hand keyboard focus back to the terminal when leaving a window.
+    // Backgrounded so the switch does not wait on osascript.
+    if (caps.flags & GRAPHICS_CAP_TERMINAL) {
+        std::system("osascript -e 'tell application \"Terminal\" to activate' >/dev/null 2>&1 &");
+    }
+#endif
+
+    // Initialization and resume return once the window or terminal is
+    // usable; one non-blocking pump lets it process the map and focus
+    // events before the first frame instead of sleeping on them.
+    if (_libraryManager.hasCurrentInterface(libraryIndex))
+        lib->waitForInput(0);
+    return 0;
+}
+
+void GameEngine::shutdownLibraries() {
+    int currentIndex = _libraryManager.getCurrentLibraryIndex();
+    for (size_t i = 0; i < _libraryManager.getLibraryCount(); ++i) {
+        int index = static_cast<int>(i);
+        IGraphicsLibrary* lib = _libraryManager.getLibrary(index);
+        if (lib && (index == currentIndex || _libraryManager.isLibrarySuspended(index))) {
+            lib->shutdown();
+            _libraryManager.setLibrarySuspended(index, false);
         }
     }
 }
@@ -663,6 +1004,10 @@ void GameEngine::clearError() {
 }
 
 void GameEngine::syncBonusSettings() {
+    // The board belongs to the simulation thread while it runs
+    if (_simThread.isRunning()) {
+        return;
+    }
     if (!_menuSystem.isBonusFeaturesAvailable() && !_usingBonusMap) {
         return;
     }
@@ -727,42 +1072,3 @@ void GameEngine::applyMenuSettings() {
     std::cout << "  Speed: " << settings.gameSpeedLabel << std::endl;
     std::cout << "  Wrap around: " << (settings.wrapAroundEdges ? "ON" : "OFF") << std::endl;
 }
-
-void GameEngine::performIntermediateSwitch(int intermediateIndex, int finalIndex) {
-    // First switch to the intermediate library (SDL2 to clean OpenGL state)
-    IGraphicsLibrary* currentLib = _libraryManager.getCurrentLibrary();
-
-    if (currentLib) {
-        currentLib->shutdown();
-        std::this_thread::sleep_for(std::chrono::milliseconds(300));
-    }
-
-    // Switch to intermediate library
-    if (_libraryManager.switchToLibrary(intermediateIndex) == 0) {
-        IGraphicsLibrary* intermediateLib = _libraryManager.getCurrentLibrary();
-        if (intermediateLib && intermediateLib->initialize() == 0) {
-            intermediateLib->setFrameRate(60);
-            intermediateLib->setMenuSystem(&_menuSystem);
-
-            // Very brief operation with the intermediate library to clean OpenGL state
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
-
-            // Now shutdown the intermediate library
-            intermediateLib->shutdown();
-            std::this_thread::sleep_for(std::chrono::milliseconds(200));
-        }
-    }
-
-    // Now switch to the final library (Raylib)
-    if (_libraryManager.switchToLibrary(finalIndex) == 0) {
-        IGraphicsLibrary* finalLib = _libraryManager.getCurrentLibrary();
-        if (finalLib && finalLib->initialize() == 0) {
-            finalLib->setFrameRate(60);
-            finalLib->setMenuSystem(&_menuSystem);
-
-            const char* finalLibName = _libraryManager.getLibraryName(finalIndex);
-            std::string message = std::string("Switched to: ") + (finalLibName ? finalLibName : "Unknown Library");
-            finalLib->setSwitchMessage(message, 120);
-        }
-    }
-}
@@ -4,10 +4,13 @@
 #include "LibraryManager.hpp"
 #include "IGraphicsLibrary.hpp"
 #include "MenuSystem.hpp"
+#include <chrono>
 #include <string>
 #include <optional>
 
 #include "file_utils.hpp"
+#include "replay_log.hpp"
+#include "SimulationThread.hpp"
 
 class GameEngine {
   public:
@@ -19,6 +22,21 @@ class GameEngine {
     bool isInitialized() const;
   // Bonus: load a custom game mode / map file (nibbler rules file)
   int loadBonusMap(const char* path);
+  // Record every game played in this session to a binary replay log, one
+  // file per game named by replay_game_path
+  void setRecordPath(const std::string& path);
+  // Re-run a replay log at full speed, rendering through the current library
+  int runReplay(const char* path);
+  // Simulation ticks per second fed to update_game_map, independent of the
+  // render rate, and the most ticks run in one frame before the backlog is
+  // dropped
+  void setTickRate(int ticksPerSecond);
+  void setMaxCatchUpTicks(int ticks);
+  // Render frame cap; 0 renders as fast as the library allows
+  void setRenderFrameRate(int fps);
+  // Run update_game_map on a separate thread while a game is in progress;
+  // input and rendering stay on the calling thread
+  void setThreadedSimulation(bool enabled);
 
   private:
     game_data _gameData;
@@ -32,24 +50,52 @@ class GameEngine {
     int _defaultLibIndex;
     bool _libSlotAvailable[4];
     int _lastAppliedFPS;
+    int _tickRate;
+    int _maxCatchUpTicks;
+    double _tickAccumulator;
+    std::chrono::steady_clock::time_point _lastUpdateTime;
+    IGraphicsLibrary* _lastRenderedLib;
+    uint64_t _lastRenderedGeneration;
+    RenderSnapshot _renderSnapshot;
+    bool _threadedSimulation;
     int _baselineBoardWidth;
     int _baselineBoardHeight;
     bool _baselineWrapAroundEdges;
     bool _baselineAdditionalFoodItems;
 
+    static const int INPUT_BATCH_SIZE = 32;
+
     void gameLoop();
+    bool pumpInput(bool& shouldQuit);
+    bool nextTickTime(std::chrono::steady_clock::time_point& tickAt) const;
+    int waitForFrameEnd(std::chrono::steady_clock::time_point frameEnd, bool& shouldQuit);
     void handleInput(GameKey key, bool& shouldQuit);
+    void steerSnake(int direction);
+    void stopRecording();
+    void startSimulationThread();
     void updateGame(bool& shouldQuit, double deltaTime);
     void renderGame();
     void applyMenuSettings();
     void syncBonusSettings();
-    int loadDefaultLibraries();
+    int loadDefaultLibraries(int preferredSlot);
     void switchGraphicsLibrary(int libraryIndex);
-    void performIntermediateSwitch(int intermediateIndex, int finalIndex);
+    void deactivateLibrary(int libraryIndex);
+    int activateLibrary(int libraryIndex, bool& warm);
+    void shutdownLibraries();
+    void applyVsync(int libraryIndex, bool enabled);
+    void logCapabilities(int libraryIndex) const;
+    bool libraryFitsBoard(int libraryIndex) const;
     void handleGameOver();
     void prepareBoardForNextGame();
     void setError(const std::string& error);
     void clearError();
 
     std::optional<game_rules> _cachedBonusRules;
+    std::string _recordPath;
+    // Games recorded so far and the file of the current one
+    int _recordedGames;
+    std::string _recordFile;
+    replay_recorder _recorder;
+    // Declared last so it is stopped before the members it ticks go away
+    SimulationThread _simThread;
 };
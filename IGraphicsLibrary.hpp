@@ -1,5 +1,9 @@
 #pragma once
 
+#include "RenderSnapshot.hpp"
+
+#include <chrono>
+#include <cstdint>
 #include <string>
 
 class game_data;
@@ -19,6 +23,49 @@ enum class GameKey {
     QUIT
 };
 
+// Version of the plugin interface below. A plugin exporting capabilities
+// for another version is treated like one that exports none. Version 1
+// declared the newer IGraphicsLibrary methods ahead of the original ones.
+static const uint32_t GRAPHICS_ABI_VERSION = 2;
+
+enum GraphicsCapabilityFlag : uint32_t {
+    // Draws from the RenderSnapshot alone, without snapshot.source; needed
+    // while the simulation runs on its own thread
+    GRAPHICS_CAP_SNAPSHOT_RENDER = 1u << 0,
+    // Patches only snapshot.dirtyCells unless snapshot.fullRedraw is set
+    GRAPHICS_CAP_INCREMENTAL_RENDER = 1u << 1,
+    // Honours setVsync()
+    GRAPHICS_CAP_VSYNC_CONTROL = 1u << 2,
+    // render() may be called from a thread other than the one that called
+    // initialize(); none of the bundled window systems allow it
+    GRAPHICS_CAP_THREADED_RENDER = 1u << 3,
+    // Draws in the terminal the game was started from rather than a window
+    GRAPHICS_CAP_TERMINAL = 1u << 4
+};
+
+// Optional descriptor a plugin exports through getGraphicsCapabilities().
+// Plugins without one are driven through the oldest code paths: no flags
+// and no board limit.
+struct GraphicsCapabilities {
+    uint32_t abiVersion;
+    // sizeof(GraphicsCapabilities) in the plugin's build; fields past it
+    // keep their defaults
+    uint32_t size;
+    uint32_t flags;
+    // Largest board the library can draw legibly, 0 when unbounded
+    int maxBoardWidth;
+    int maxBoardHeight;
+    // Edge in pixels of the tile atlas cells the library draws best with,
+    // 0 when it does not draw from an atlas
+    int preferredTileSize;
+};
+
+struct InputEvent {
+    GameKey key;
+    // steady_clock time the library saw the key, in nanoseconds
+    int64_t timestampNs;
+};
+
 class IGraphicsLibrary {
   public:
     virtual ~IGraphicsLibrary() = default;
@@ -41,6 +88,63 @@ class IGraphicsLibrary {
         (void)message;
         (void)timer;
     }
+
+    // Everything below was added after the first plugin interface. Slots
+    // are only ever appended so the ones above keep their vtable offsets;
+    // the engine calls these only on plugins reporting GRAPHICS_ABI_VERSION.
+
+    // Hot-swap support. suspend() hides the window or leaves the terminal
+    // screen but keeps the context, fonts and textures alive, and returns
+    // false when the library cannot do that; the engine then calls
+    // shutdown() instead. resume() shows a suspended library again and
+    // returns 0, or nonzero to have the engine shut it down and call
+    // initialize() from scratch.
+    virtual bool suspend() {
+        return false;
+    }
+    virtual int resume() {
+        return 1;
+    }
+    // Preferred entry point: the engine builds one snapshot per frame and
+    // hands it to the active library. Libraries that only implement the
+    // game_data overload keep working through this default.
+    virtual void render(const RenderSnapshot& snapshot) {
+        if (snapshot.source)
+            render(*snapshot.source);
+    }
+    // Drains pending keys into events, oldest first, and returns how many
+    // were written. The default calls getInput() until it reports no key;
+    // menu keys the library handles itself end the batch early.
+    virtual int pollInputEvents(InputEvent* events, int maxEvents) {
+        return pollGetInput(events, maxEvents);
+    }
+    // Blocks until input is pending or timeoutMs elapsed. Returns 1 when
+    // input may be pending, 0 on timeout and -1 when the library cannot
+    // wait, in which case the caller sleeps instead.
+    virtual int waitForInput(int timeoutMs) {
+        (void)timeoutMs;
+        return -1;
+    }
+    // Only called on libraries reporting GRAPHICS_CAP_VSYNC_CONTROL
+    virtual void setVsync(bool enabled) {
+        (void)enabled;
+    }
+
+    // The default pollInputEvents(), also used by the engine on plugins
+    // built before it existed. Not virtual, so it adds no vtable slot.
+    int pollGetInput(InputEvent* events, int maxEvents) {
+        int count = 0;
+        while (count < maxEvents) {
+            GameKey key = getInput();
+            if (key == GameKey::NONE)
+                break;
+            events[count].key = key;
+            events[count].timestampNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+            ++count;
+        }
+        return count;
+    }
 };
 
 extern "C" {
@@ -48,4 +152,6 @@ IGraphicsLibrary* createGraphicsLibrary();
 void destroyGraphicsLibrary(IGraphicsLibrary* lib);
 const char* getLibraryName();
 const char* getLibraryVersion();
+// Optional; see GraphicsCapabilities
+const GraphicsCapabilities* getGraphicsCapabilities();
 }
\ No newline at end of file
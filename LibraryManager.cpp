@@ -1,12 +1,134 @@
 #include "LibraryManager.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <dlfcn.h>
+#include <fstream>
 #include <iostream>
 
+#if defined(__linux__)
+#include <elf.h>
+#include <link.h>
+#endif
+
+static const char* const REQUIRED_ENTRY_POINTS[] = {
+    "createGraphicsLibrary",
+    "destroyGraphicsLibrary",
+    "getLibraryName",
+    "getLibraryVersion"
+};
+static const size_t REQUIRED_ENTRY_POINT_COUNT = sizeof(REQUIRED_ENTRY_POINTS) / sizeof(REQUIRED_ENTRY_POINTS[0]);
+
+static const GraphicsCapabilities LEGACY_CAPABILITIES = {0, sizeof(GraphicsCapabilities), 0, 0, 0, 0};
+
+static bool readAt(std::ifstream& file, uint64_t offset, void* out, size_t size) {
+    file.clear();
+    file.seekg(static_cast<std::streamoff>(offset));
+    file.read(static_cast<char*>(out), static_cast<std::streamsize>(size));
+    return static_cast<size_t>(file.gcount()) == size;
+}
+
+// Checks a plugin from its file alone, without running any of its code or
+// pulling in its dependencies. On ELF platforms the header has to match
+// this process and the dynamic symbol table has to define every entry
+// point; elsewhere only readability is checked and dlopen has the last
+// word.
+static bool probeSharedObject(const std::string& path, std::string& error) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        error = "Failed to load library: cannot open " + path;
+        return false;
+    }
+#if defined(__linux__)
+    ElfW(Ehdr) header;
+    if (!readAt(file, 0, &header, sizeof(header)) || std::memcmp(header.e_ident, ELFMAG, SELFMAG) != 0) {
+        error = "Failed to load library: " + path + " is not a shared object";
+        return false;
+    }
+
+    unsigned char hostClass = (sizeof(void*) == 8) ? ELFCLASS64 : ELFCLASS32;
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    unsigned char hostData = ELFDATA2LSB;
+#else
+    unsigned char hostData = ELFDATA2MSB;
+#endif
+    bool machineMatches = true;
+#if defined(__x86_64__)
+    machineMatches = (header.e_machine == EM_X86_64);
+#elif defined(__aarch64__)
+    machineMatches = (header.e_machine == EM_AARCH64);
+#elif defined(__i386__)
+    machineMatches = (header.e_machine == EM_386);
+#endif
+    if (header.e_ident[EI_CLASS] != hostClass || header.e_ident[EI_DATA] != hostData ||
+        header.e_ident[EI_VERSION] != EV_CURRENT || header.e_type != ET_DYN || !machineMatches) {
+        error = "Failed to load library: " + path + " was built for another platform";
+        return false;
+    }
+    if (header.e_shentsize != sizeof(ElfW(Shdr)) || header.e_shnum == 0) {
+        error = "Failed to load library: " + path + " has no section table";
+        return false;
+    }
+
+    std::vector<ElfW(Shdr)> sections(header.e_shnum);
+    if (!readAt(file, header.e_shoff, sections.data(), sections.size() * sizeof(ElfW(Shdr)))) {
+        error = "Failed to load library: " + path + " is truncated";
+        return false;
+    }
+
+    // Symbol and string tables of a plugin are a few kilobytes; anything
+    // far larger means a corrupt section header
+    static const uint64_t MAX_TABLE_SIZE = 16u << 20;
+    bool found[REQUIRED_ENTRY_POINT_COUNT] = {};
+    for (const ElfW(Shdr)& section : sections) {
+        if (section.sh_type != SHT_DYNSYM || section.sh_link >= sections.size())
+            continue;
+        const ElfW(Shdr)& stringSection = sections[section.sh_link];
+        if (section.sh_size > MAX_TABLE_SIZE || stringSection.sh_size > MAX_TABLE_SIZE)
+            break;
+
+        std::vector<ElfW(Sym)> symbols(section.sh_size / sizeof(ElfW(Sym)));
+        std::string strings(stringSection.sh_size, '\0');
+        if (!readAt(file, section.sh_offset, symbols.data(), symbols.size() * sizeof(ElfW(Sym))) ||
+            !readAt(file, stringSection.sh_offset, &strings[0], strings.size())) {
+            error = "Failed to load library: " + path + " is truncated";
+            return false;
+        }
+        strings.push_back('\0');
+
+        for (const ElfW(Sym)& symbol : symbols) {
+            if (symbol.st_shndx == SHN_UNDEF || ELF64_ST_TYPE(symbol.st_info) != STT_FUNC ||
+                symbol.st_name >= strings.size())
+                continue;
+            const char* name = strings.c_str() + symbol.st_name;
+            for (size_t i = 0; i < REQUIRED_ENTRY_POINT_COUNT; ++i) {
+                if (std::strcmp(name, REQUIRED_ENTRY_POINTS[i]) == 0)
+                    found[i] = true;
+            }
+        }
+        break;
+    }
+    for (size_t i = 0; i < REQUIRED_ENTRY_POINT_COUNT; ++i) {
+        if (!found[i]) {
+            error = std::string("Library missing required function ") + REQUIRED_ENTRY_POINTS[i] + " in " + path;
+            return false;
+        }
+    }
+#else
+    (void)readAt;
+#endif
+    error.clear();
+    return true;
+}
+
 LibraryManager::LibraryManager() : _currentLibraryIndex(-1) {
     clearError();
 }
 
 LibraryManager::~LibraryManager() {
+    finishProbe();
+
     // Clean up all loaded libraries
     for (auto& libInfo : _libraries) {
         cleanupLibrary(libInfo);
@@ -15,55 +137,141 @@ LibraryManager::~LibraryManager() {
 }
 
 int LibraryManager::loadLibrary(const std::string& libraryPath) {
+    int index = registerLibrary(libraryPath, "Unknown Library");
+    if (index < 0) {
+        return 1;
+    }
+    if (ensureLoaded(index) != 0) {
+        _libraries.erase(_libraries.begin() + index);
+        return 1;
+    }
+
+    // If this is the first library, make it active
+    if (_currentLibraryIndex == -1) {
+        _currentLibraryIndex = index;
+    }
+
+    return 0;
+}
+
+int LibraryManager::registerLibrary(const std::string& libraryPath, const std::string& displayName) {
+    clearError();
+
+    if (_probeThread.joinable()) {
+        setError("Cannot register a library while the probe is running");
+        return -1;
+    }
+
+    LibraryInfo libInfo;
+    libInfo.handle = nullptr;
+    libInfo.instance = nullptr;
+    libInfo.path = libraryPath;
+    libInfo.name = displayName;
+    libInfo.suspended = false;
+    libInfo.failed = false;
+    libInfo.capabilities = LEGACY_CAPABILITIES;
+    libInfo.createFunc = nullptr;
+    libInfo.destroyFunc = nullptr;
+    libInfo.getNameFunc = nullptr;
+    libInfo.getVersionFunc = nullptr;
+
+    _libraries.push_back(libInfo);
+    return static_cast<int>(_libraries.size() - 1);
+}
+
+void LibraryManager::startProbe() {
+    if (_probeThread.joinable()) {
+        return;
+    }
+
+    // The thread gets its own copy of the paths; _probeResults is not
+    // touched on this side until finishProbe() joins it
+    std::vector<std::string> paths;
+    for (const auto& libInfo : _libraries) {
+        paths.push_back((libInfo.instance || libInfo.failed) ? std::string() : libInfo.path);
+    }
+    _probeResults.assign(paths.size(), ProbeResult{false, true, std::string()});
+    _probeThread = std::thread([this, paths]() { runProbe(paths); });
+}
+
+void LibraryManager::finishProbe() {
+    if (!_probeThread.joinable()) {
+        return;
+    }
+    _probeThread.join();
+
+    for (size_t i = 0; i < _probeResults.size() && i < _libraries.size(); ++i) {
+        LibraryInfo& libInfo = _libraries[i];
+        if (_probeResults[i].checked && !_probeResults[i].usable && !libInfo.instance) {
+            libInfo.failed = true;
+            libInfo.failure = _probeResults[i].error;
+        }
+    }
+    _probeResults.clear();
+}
+
+void LibraryManager::runProbe(const std::vector<std::string>& paths) {
+    for (size_t i = 0; i < paths.size(); ++i) {
+        if (paths[i].empty()) {
+            continue;
+        }
+        ProbeResult& result = _probeResults[i];
+        result.usable = probeSharedObject(paths[i], result.error);
+        result.checked = true;
+    }
+}
+
+int LibraryManager::ensureLoaded(int libraryIndex) {
     clearError();
 
+    if (libraryIndex < 0 || libraryIndex >= static_cast<int>(_libraries.size())) {
+        setError("Invalid library index");
+        return 1;
+    }
+
+    LibraryInfo& libInfo = _libraries[libraryIndex];
+    if (libInfo.instance) {
+        return 0;
+    }
+    if (libInfo.failed) {
+        setError(libInfo.failure);
+        return 1;
+    }
+
     // Load the shared library
-    void* handle = dlopen(libraryPath.c_str(), RTLD_LAZY);
+    void* handle = dlopen(libInfo.path.c_str(), RTLD_LAZY);
     if (!handle) {
         setError(std::string("Failed to load library: ") + dlerror());
+        libInfo.failed = true;
+        libInfo.failure = _lastError;
         return 1;
     }
-
-    LibraryInfo libInfo;
     libInfo.handle = handle;
-    libInfo.path = libraryPath;
-    libInfo.instance = nullptr;
 
     // Load the required symbols
     if (!loadLibrarySymbols(libInfo)) {
-        dlclose(handle);
+        cleanupLibrary(libInfo);
+        libInfo.failed = true;
+        libInfo.failure = _lastError;
         return 1;
     }
 
     // Get library name
     if (libInfo.getNameFunc) {
         libInfo.name = libInfo.getNameFunc();
-    } else {
-        libInfo.name = "Unknown Library";
     }
+    loadCapabilities(libInfo);
 
     // Create an instance of the library
-    if (libInfo.createFunc) {
-        libInfo.instance = libInfo.createFunc();
-        if (!libInfo.instance) {
-            setError("Failed to create library instance");
-            dlclose(handle);
-            return 1;
-        }
-    } else {
-        setError("Library does not provide createGraphicsLibrary function");
-        dlclose(handle);
+    libInfo.instance = libInfo.createFunc();
+    if (!libInfo.instance) {
+        setError("Failed to create library instance");
+        cleanupLibrary(libInfo);
+        libInfo.failed = true;
+        libInfo.failure = _lastError;
         return 1;
     }
 
-    // Add to our list of libraries
-    _libraries.push_back(libInfo);
-
-    // If this is the first library, make it active
-    if (_currentLibraryIndex == -1) {
-        _currentLibraryIndex = static_cast<int>(_libraries.size() - 1);
-    }
-
     return 0;
 }
 
@@ -82,10 +290,7 @@ void LibraryManager::unloadCurrentLibrary() {
 }
 
 int LibraryManager::switchToLibrary(int libraryIndex) {
-    clearError();
-
-    if (libraryIndex < 0 || libraryIndex >= static_cast<int>(_libraries.size())) {
-        setError("Invalid library index");
+    if (ensureLoaded(libraryIndex) != 0) {
         return 1;
     }
 
@@ -100,6 +305,58 @@ IGraphicsLibrary* LibraryManager::getCurrentLibrary() const {
     return nullptr;
 }
 
+IGraphicsLibrary* LibraryManager::getLibrary(int index) const {
+    if (index >= 0 && index < static_cast<int>(_libraries.size())) {
+        return _libraries[index].instance;
+    }
+    return nullptr;
+}
+
+bool LibraryManager::isLibraryLoaded(int index) const {
+    if (index >= 0 && index < static_cast<int>(_libraries.size())) {
+        return _libraries[index].instance != nullptr;
+    }
+    return false;
+}
+
+bool LibraryManager::isLibraryUsable(int index) const {
+    if (index >= 0 && index < static_cast<int>(_libraries.size())) {
+        return !_libraries[index].failed;
+    }
+    return false;
+}
+
+const char* LibraryManager::getLibraryError(int index) const {
+    if (index >= 0 && index < static_cast<int>(_libraries.size())) {
+        return _libraries[index].failure.c_str();
+    }
+    return nullptr;
+}
+
+const GraphicsCapabilities& LibraryManager::getCapabilities(int index) const {
+    if (index >= 0 && index < static_cast<int>(_libraries.size())) {
+        return _libraries[index].capabilities;
+    }
+    return LEGACY_CAPABILITIES;
+}
+
+bool LibraryManager::hasCurrentInterface(int index) const {
+    return getCapabilities(index).abiVersion >= GRAPHICS_ABI_VERSION;
+}
+
+bool LibraryManager::isLibrarySuspended(int index) const {
+    if (index >= 0 && index < static_cast<int>(_libraries.size())) {
+        return _libraries[index].suspended;
+    }
+    return false;
+}
+
+void LibraryManager::setLibrarySuspended(int index, bool suspended) {
+    if (index >= 0 && index < static_cast<int>(_libraries.size())) {
+        _libraries[index].suspended = suspended;
+    }
+}
+
 int LibraryManager::getCurrentLibraryIndex() const {
     return _currentLibraryIndex;
 }
@@ -165,6 +422,30 @@ bool LibraryManager::loadLibrarySymbols(LibraryInfo& libInfo) {
     return true;
 }
 
+void LibraryManager::loadCapabilities(LibraryInfo& libInfo) {
+    libInfo.capabilities = LEGACY_CAPABILITIES;
+
+    dlerror();
+    auto capabilitiesFunc = reinterpret_cast<const GraphicsCapabilities* (*)()>(
+        dlsym(libInfo.handle, "getGraphicsCapabilities"));
+    if (!capabilitiesFunc) {
+        // Older plugin; the entry point is optional
+        dlerror();
+        return;
+    }
+
+    const GraphicsCapabilities* reported = capabilitiesFunc();
+    if (!reported || reported->abiVersion != GRAPHICS_ABI_VERSION ||
+        reported->size < offsetof(GraphicsCapabilities, flags) + sizeof(reported->flags)) {
+        std::cerr << "Ignoring capabilities of " << libInfo.name << ": built for another plugin interface" << std::endl;
+        return;
+    }
+    // A plugin built with a shorter descriptor leaves the newer fields at
+    // their defaults; a longer one has its extra fields ignored
+    std::memcpy(&libInfo.capabilities, reported, std::min<size_t>(reported->size, sizeof(GraphicsCapabilities)));
+    libInfo.capabilities.size = sizeof(GraphicsCapabilities);
+}
+
 void LibraryManager::cleanupLibrary(LibraryInfo& libInfo) {
     if (libInfo.instance && libInfo.destroyFunc) {
         libInfo.destroyFunc(libInfo.instance);
@@ -2,6 +2,7 @@
 
 #include "IGraphicsLibrary.hpp"
 #include <string>
+#include <thread>
 #include <vector>
 
 class LibraryManager {
@@ -9,14 +10,58 @@ class LibraryManager {
     LibraryManager();
     ~LibraryManager();
 
+    // Registers and loads a library right away
     int loadLibrary(const std::string& libraryPath);
 
+    // Registers a library without opening it and returns its index, or -1.
+    // The name is shown until the library reports its own on load.
+    int registerLibrary(const std::string& libraryPath, const std::string& displayName);
+
+    // Checks every registered library that is not loaded yet on a
+    // background thread: the file must be a shared object for this
+    // platform exporting the plugin entry points. Register all libraries
+    // before starting; finishProbe() waits for the results.
+    void startProbe();
+
+    void finishProbe();
+
+    // dlopens a registered library and creates its instance if that has
+    // not happened yet. Fails without opening the file when the probe
+    // already rejected it.
+    int ensureLoaded(int libraryIndex);
+
     void unloadCurrentLibrary();
 
+    // Loads the library first if needed
     int switchToLibrary(int libraryIndex);
 
     IGraphicsLibrary* getCurrentLibrary() const;
 
+    IGraphicsLibrary* getLibrary(int index) const;
+
+    bool isLibraryLoaded(int index) const;
+
+    // False once the probe or a load attempt rejected the library
+    bool isLibraryUsable(int index) const;
+
+    // Why the probe or the last load attempt rejected the library
+    const char* getLibraryError(int index) const;
+
+    // What a loaded library reported through getGraphicsCapabilities(),
+    // or the legacy defaults when it exports nothing usable
+    const GraphicsCapabilities& getCapabilities(int index) const;
+
+    // Whether the library was built against this GRAPHICS_ABI_VERSION and
+    // so implements the IGraphicsLibrary methods after setSwitchMessage().
+    // Older plugins must only be driven through the original ones.
+    bool hasCurrentInterface(int index) const;
+
+    // Set while a library is suspended in the background, warm for a
+    // quick switch back
+    bool isLibrarySuspended(int index) const;
+
+    void setLibrarySuspended(int index, bool suspended);
+
     int getCurrentLibraryIndex() const;
 
     size_t getLibraryCount() const;
@@ -33,6 +78,10 @@ class LibraryManager {
         IGraphicsLibrary* instance;
         std::string path;
         std::string name;
+        bool suspended;
+        bool failed;
+        std::string failure;
+        GraphicsCapabilities capabilities;
 
         IGraphicsLibrary* (*createFunc)();
         void (*destroyFunc)(IGraphicsLibrary*);
@@ -40,12 +89,23 @@ class LibraryManager {
         const char* (*getVersionFunc)();
     };
 
+    // Written only by the probe thread until finishProbe() joins it
+    struct ProbeResult {
+        bool checked;
+        bool usable;
+        std::string error;
+    };
+
     std::vector<LibraryInfo> _libraries;
+    std::vector<ProbeResult> _probeResults;
+    std::thread _probeThread;
     int _currentLibraryIndex;
     std::string _lastError;
 
     void clearError();
     void setError(const std::string& error);
     bool loadLibrarySymbols(LibraryInfo& libInfo);
+    void loadCapabilities(LibraryInfo& libInfo);
     void cleanupLibrary(LibraryInfo& libInfo);
-};
\ No newline at end of file
+    void runProbe(const std::vector<std::string>& paths);
+};
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class game_data;
+
+// What a renderer draws in one cell. Snake cells only tell head from body;
+// items take precedence over the terrain underneath them.
+enum class RenderTile : uint8_t {
+    TILE_EMPTY = 0,
+    TILE_WALL,
+    TILE_ICE,
+    TILE_FIRE,
+    TILE_FOOD,
+    TILE_FIRE_FOOD,
+    TILE_FROSTY_FOOD,
+    TILE_SNAKE_HEAD,
+    TILE_SNAKE_BODY
+};
+
+struct RenderHead {
+    int x;
+    int y;
+};
+
+// Packed, read-only copy of everything a renderer needs from the board for
+// one frame. Built by game_data::build_render_snapshot in a single pass.
+struct RenderSnapshot {
+    // game_data::get_board_generation() at build time
+    uint64_t generation;
+    int width;
+    int height;
+    // One RenderTile per cell, row-major
+    std::vector<uint8_t> tiles;
+    // Generation the dirty list is relative to. A renderer that did not
+    // draw that generation last has to treat the snapshot as a full redraw.
+    uint64_t baseGeneration;
+    // Cells changed since baseGeneration; ignore when fullRedraw is set
+    std::vector<uint32_t> dirtyCells;
+    bool fullRedraw;
+    // Head position per player, {-1, -1} for inactive snakes
+    RenderHead heads[4];
+    int snakeLength[4];
+    // How far each snake is from its last move to its next one, 0 right
+    // after a move up to 1 when the next is due; 0 for snakes that are
+    // inactive or not moving. Renderers can use it to draw heads part way
+    // into the next cell.
+    float movePhase[4];
+    int applesEaten;
+    // Board the snapshot was taken from, for menu pages and libraries that
+    // still implement render(const game_data&). Only valid during the
+    // render call on the engine thread.
+    const game_data* source;
+
+    RenderSnapshot() : generation(0), width(0), height(0), baseGeneration(0), fullRedraw(true),
+                       applesEaten(0), source(nullptr) {
+        for (int i = 0; i < 4; ++i) {
+            heads[i].x = -1;
+            heads[i].y = -1;
+            snakeLength[i] = 0;
+            movePhase[i] = 0.0f;
+        }
+    }
+
+    RenderTile at(int x, int y) const {
+        return static_cast<RenderTile>(tiles[static_cast<size_t>(y) * static_cast<size_t>(width) + static_cast<size_t>(x)]);
+    }
+};
@@ -0,0 +1,130 @@
+#include "SimulationThread.hpp"
+#include "game_data.hpp"
+#include "replay_log.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <system_error>
+
+SimulationThread::SimulationThread()
+    : _stopRequested(false), _gameOver(false), _running(false), _game(nullptr),
+      _recorder(nullptr), _tickRate(120), _maxCatchUpTicks(8), _speedMultiplier(1.0) {}
+
+SimulationThread::~SimulationThread() {
+    stop();
+}
+
+int SimulationThread::start(game_data& game, replay_recorder& recorder, int tickRate, int maxCatchUpTicks,
+                            double speedMultiplier) {
+    if (_running || tickRate <= 0 || maxCatchUpTicks <= 0 || speedMultiplier <= 0.0)
+        return 1;
+    _game = &game;
+    _recorder = &recorder;
+    _tickRate = tickRate;
+    _maxCatchUpTicks = maxCatchUpTicks;
+    _speedMultiplier = speedMultiplier;
+    _stopRequested.store(false, std::memory_order_relaxed);
+    _gameOver.store(false, std::memory_order_relaxed);
+    _commands.clear();
+    _snapshots.reset();
+
+    // The reader gets the starting board before the first tick runs
+    _game->request_full_redraw();
+    publishSnapshot(0.0);
+    try {
+        _thread = std::thread(&SimulationThread::run, this);
+    } catch (const std::system_error&) {
+        return 1;
+    }
+    _running = true;
+    return 0;
+}
+
+void SimulationThread::stop() {
+    if (!_running)
+        return;
+    _stopRequested.store(true, std::memory_order_release);
+    if (_thread.joinable())
+        _thread.join();
+    _running = false;
+}
+
+bool SimulationThread::isRunning() const {
+    return _running;
+}
+
+bool SimulationThread::pushDirection(int player, int direction) {
+    DirectionCommand command = {player, direction};
+    return _commands.push(command);
+}
+
+bool SimulationThread::acquireSnapshot() {
+    return _snapshots.acquire();
+}
+
+RenderSnapshot& SimulationThread::snapshot() {
+    return _snapshots.front();
+}
+
+bool SimulationThread::isGameOver() const {
+    return _gameOver.load(std::memory_order_acquire);
+}
+
+void SimulationThread::drainCommands() {
+    DirectionCommand command;
+    while (_commands.pop(command)) {
+        _game->queue_direction(command.player, command.direction);
+        _recorder->record_turn(command.player, command.direction);
+    }
+}
+
+// pending is the game time banked towards the next tick
+void SimulationThread::publishSnapshot(double pending) {
+    RenderSnapshot& back = _snapshots.back();
+    _game->build_render_snapshot(back);
+    _game->fill_move_phase(back, pending);
+    // The board keeps changing under the reader, so it gets no pointer to it
+    back.source = nullptr;
+    _game->acknowledge_dirty_cells();
+    _snapshots.publish();
+}
+
+void SimulationThread::run() {
+    const double tickLength = 1.0 / _tickRate;
+    double accumulator = 0.0;
+    auto last = std::chrono::steady_clock::now();
+    while (!_stopRequested.load(std::memory_order_acquire)) {
+        auto now = std::chrono::steady_clock::now();
+        accumulator += std::chrono::duration<double>(now - last).count() * _speedMultiplier;
+        last = now;
+
+        // Steering sent before these ticks applies to them, as in the
+        // single-threaded loop
+        drainCommands();
+        int ticksRun = 0;
+        bool ended = false;
+        while (accumulator >= tickLength) {
+            if (ticksRun >= _maxCatchUpTicks) {
+                accumulator = std::fmod(accumulator, tickLength);
+                break;
+            }
+            accumulator -= tickLength;
+            ++ticksRun;
+            _recorder->record_step(tickLength);
+            if (_game->update_game_map(tickLength) != 0) {
+                ended = true;
+                break;
+            }
+        }
+        if (ticksRun > 0)
+            publishSnapshot(accumulator);
+        if (ended) {
+            _gameOver.store(true, std::memory_order_release);
+            return;
+        }
+        // Sleep until the next tick is due
+        double wait = (tickLength - accumulator) / _speedMultiplier;
+        std::this_thread::sleep_until(now + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                                std::chrono::duration<double>(wait)));
+    }
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "SnapshotExchange.hpp"
+#include "SpscQueue.hpp"
+
+#include <atomic>
+#include <thread>
+
+class game_data;
+class replay_recorder;
+
+// Runs update_game_map on its own thread at a fixed tick rate, so a slow
+// present or font upload on the render thread cannot delay ticks. The
+// engine thread sends steering through an SPSC queue and reads board
+// snapshots from a triple buffer; it must not touch the game_data or the
+// recorder while the thread is running.
+class SimulationThread {
+  public:
+    SimulationThread();
+    ~SimulationThread();
+
+    int start(game_data& game, replay_recorder& recorder, int tickRate, int maxCatchUpTicks,
+              double speedMultiplier);
+    void stop();
+    bool isRunning() const;
+
+    // Engine thread side
+    bool pushDirection(int player, int direction);
+    bool acquireSnapshot();
+    RenderSnapshot& snapshot();
+    // Set once a tick ended the game; the thread then exits on its own
+    bool isGameOver() const;
+
+  private:
+    struct DirectionCommand {
+        int player;
+        int direction;
+    };
+
+    std::thread _thread;
+    std::atomic<bool> _stopRequested;
+    std::atomic<bool> _gameOver;
+    bool _running;
+    SpscQueue<DirectionCommand, 64> _commands;
+    SnapshotExchange _snapshots;
+
+    game_data* _game;
+    replay_recorder* _recorder;
+    int _tickRate;
+    int _maxCatchUpTicks;
+    double _speedMultiplier;
+
+    void run();
+    void drainCommands();
+    void publishSnapshot(double pending);
+};
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "RenderSnapshot.hpp"
+
+#include <atomic>
+#include <cstdint>
+
+// Lock-free triple buffer handing RenderSnapshots from the simulation thread
+// to the render thread. The writer fills back() and publishes it; the reader
+// picks up the newest published snapshot with acquire() and draws front().
+// Neither side ever waits, and snapshots the reader was too slow to take are
+// overwritten.
+class SnapshotExchange {
+  public:
+    SnapshotExchange() : _middle(1), _back(0), _front(2) {}
+
+    // Writer side
+    RenderSnapshot& back() {
+        return _slots[_back];
+    }
+    void publish() {
+        uint8_t previous = _middle.exchange(static_cast<uint8_t>(_back | FRESH), std::memory_order_acq_rel);
+        _back = static_cast<uint8_t>(previous & INDEX_MASK);
+    }
+
+    // Reader side. Returns true when front() changed.
+    bool acquire() {
+        if ((_middle.load(std::memory_order_relaxed) & FRESH) == 0)
+            return false;
+        uint8_t previous = _middle.exchange(_front, std::memory_order_acq_rel);
+        _front = static_cast<uint8_t>(previous & INDEX_MASK);
+        return true;
+    }
+    RenderSnapshot& front() {
+        return _slots[_front];
+    }
+
+    // Only safe while neither side is running
+    void reset() {
+        _middle.store(1, std::memory_order_relaxed);
+        _back = 0;
+        _front = 2;
+        for (RenderSnapshot& slot : _slots)
+            slot = RenderSnapshot();
+    }
+
+  private:
+    static const uint8_t INDEX_MASK = 0x3;
+    static const uint8_t FRESH = 0x4;
+
+    RenderSnapshot _slots[3];
+    // Index of the shared slot, with FRESH set until the reader takes it
+    std::atomic<uint8_t> _middle;
+    uint8_t _back;
+    uint8_t _front;
+};
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+// Fixed-size ring buffer for exactly one producer thread and one consumer
+// thread. Neither side blocks: push fails when the queue is full and pop
+// fails when it is empty. Capacity must be a power of two.
+template <typename T, size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "SpscQueue capacity must be a power of two");
+
+  public:
+    SpscQueue() : _head(0), _tail(0) {}
+
+    // Producer side
+    bool push(const T& value) {
+        size_t tail = _tail.load(std::memory_order_relaxed);
+        if (tail - _head.load(std::memory_order_acquire) == Capacity)
+            return false;
+        _items[tail & (Capacity - 1)] = value;
+        _tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side
+    bool pop(T& value) {
+        size_t head = _head.load(std::memory_order_relaxed);
+        if (head == _tail.load(std::memory_order_acquire))
+            return false;
+        value = _items[head & (Capacity - 1)];
+        _head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Only safe while neither side is running
+    void clear() {
+        _head.store(0, std::memory_order_relaxed);
+        _tail.store(0, std::memory_order_relaxed);
+    }
+
+  private:
+    T _items[Capacity];
+    // Kept on separate cache lines so the two threads do not false-share
+    alignas(64) std::atomic<size_t> _head;
+    alignas(64) std::atomic<size_t> _tail;
+};
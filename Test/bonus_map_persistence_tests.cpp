@@ -2,7 +2,9 @@
 #include "../GameEngine.hpp"
 #undef private
 
+#include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <iostream>
 #include <cmath>
 #include <filesystem>
@@ -227,11 +229,68 @@ static void test_corner_tile_map_is_rejected() {
     std::cout << "Corner dead-end map rejection test passed" << std::endl;
 }
 
+static void test_fixed_timestep_caps_catch_up() {
+    GameEngine engine(20, 20);
+    engine.setTickRate(10);
+    engine.setMaxCatchUpTicks(3);
+    engine._gameData.set_wrap_around_edges(1);
+    engine._gameData.set_moves_per_second(10.0);
+    engine._gameData.reset_board();
+    engine._gameStarted = true;
+    engine._gameData.set_direction_moving(0, DIRECTION_RIGHT);
+    int startX = engine._gameData.get_head_coordinate(SNAKE_HEAD_PLAYER_1).x;
+    bool quit = false;
+
+    // A five second stall only runs the capped number of ticks.
+    engine.updateGame(quit, 5.0);
+    int headX = engine._gameData.get_head_coordinate(SNAKE_HEAD_PLAYER_1).x;
+    assert(headX == (startX + 3) % 20);
+    assert(engine._tickAccumulator >= 0.0 && engine._tickAccumulator < 0.1);
+
+    // Short frames bank time until a whole tick is available.
+    engine._tickAccumulator = 0.0;
+    engine.updateGame(quit, 0.04);
+    engine.updateGame(quit, 0.04);
+    assert(engine._gameData.get_head_coordinate(SNAKE_HEAD_PLAYER_1).x == headX);
+    assert(std::fabs(engine._tickAccumulator - 0.08) < 1e-9);
+    engine.updateGame(quit, 0.04);
+    assert(engine._gameData.get_head_coordinate(SNAKE_HEAD_PLAYER_1).x == (headX + 1) % 20);
+
+    std::cout << "Fixed timestep catch-up test passed" << std::endl;
+}
+
+static void test_next_tick_time_is_fixed() {
+    GameEngine engine(20, 20);
+    engine.setTickRate(10);
+    engine._gameData.reset_board();
+    std::chrono::steady_clock::time_point tickAt;
+    assert(!engine.nextTickTime(tickAt));
+
+    engine._gameStarted = true;
+    engine._menuSystem.setState(MenuState::IN_GAME);
+    auto lastUpdate = std::chrono::steady_clock::now() - std::chrono::milliseconds(30);
+    engine._lastUpdateTime = lastUpdate;
+    engine._tickAccumulator = 0.04;
+    double speedMultiplier = std::max(0.1, engine._menuSystem.getSettings().speedMultiplier);
+
+    // Due the rest of the tick after the last update, not after now
+    assert(engine.nextTickTime(tickAt));
+    double dueIn = std::chrono::duration<double>(tickAt - lastUpdate).count();
+    assert(std::fabs(dueIn - 0.06 / speedMultiplier) < 1e-6);
+    std::chrono::steady_clock::time_point again;
+    assert(engine.nextTickTime(again));
+    assert(again == tickAt);
+
+    std::cout << "Next tick time test passed" << std::endl;
+}
+
 int main() {
     test_bonus_map_persists_across_game_over();
     test_snake_length_resets_after_game_over();
     test_status_effects_reset_after_bonus_reload();
     test_oversized_snake_length_loads_cleanly();
     test_corner_tile_map_is_rejected();
+    test_fixed_timestep_caps_catch_up();
+    test_next_tick_time_is_fixed();
     return 0;
 }
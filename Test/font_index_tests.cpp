@@ -0,0 +1,188 @@
+#include "../graphics_libs/include/FontCache.hpp"
+
+#include <cassert>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace font_cache = graphics::font_cache;
+
+static std::filesystem::path temp_font_dir()
+{
+    return (std::filesystem::temp_directory_path() / "nibbler_font_index_test");
+}
+
+static void write_file(const std::filesystem::path &path, const std::string &content)
+{
+    std::ofstream out(path, std::ios::trunc);
+    out << content;
+}
+
+static std::string read_file(const std::filesystem::path &path)
+{
+    std::ifstream in(path);
+    return (std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()));
+}
+
+// Loader stand-in accepting only the given file names, counting attempts.
+struct fake_loader
+{
+    std::vector<std::string> accepted;
+    std::vector<std::string> tried;
+
+    bool operator()(const std::string &path)
+    {
+        this->tried.push_back(path);
+        std::string name = std::filesystem::path(path).filename().string();
+        for (const std::string &candidate : this->accepted)
+        {
+            if (candidate == name)
+                return (true);
+        }
+        return (false);
+    }
+};
+
+static std::optional<std::string> resolve_with(const char *consumer, fake_loader &loader)
+{
+    return (font_cache::resolve(consumer, {}, [&loader](const std::string &path) { return (loader(path)); }));
+}
+
+static void test_index_skips_rejected_fonts()
+{
+    std::filesystem::path dir = temp_font_dir();
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir / "fonts");
+    write_file(dir / "fonts" / "a.ttf", "a");
+    write_file(dir / "fonts" / "b.ttf", "b");
+    write_file(dir / "fonts" / "c.otf", "c");
+    write_file(dir / "fonts" / "notes.txt", "not a font");
+    std::string index = (dir / "font_index.txt").string();
+    font_cache::configure(index, {(dir / "fonts").string()});
+
+    // First run walks the directory and tries fonts in path order.
+    fake_loader first;
+    first.accepted = {"b.ttf"};
+    std::optional<std::string> chosen = resolve_with("sdl2", first);
+    assert(chosen && std::filesystem::path(*chosen).filename() == "b.ttf");
+    assert(first.tried.size() == 2);
+    assert(font_cache::get() == chosen);
+    std::string saved = read_file(index);
+    assert(saved.find("sdl2=0") != std::string::npos);
+    assert(saved.find("sdl2=1") != std::string::npos);
+    assert(saved.find("notes.txt") == std::string::npos);
+
+    // A fresh process goes straight to the font it accepted before.
+    font_cache::reset();
+    fake_loader second;
+    second.accepted = {"b.ttf"};
+    chosen = resolve_with("sdl2", second);
+    assert(chosen && second.tried.size() == 1);
+    font_cache::waitForRevalidation();
+
+    // Another loader keeps its own results; a.ttf stays rejected for sdl2.
+    font_cache::reset();
+    fake_loader other;
+    other.accepted = {"a.ttf"};
+    chosen = resolve_with("opengl", other);
+    assert(chosen && std::filesystem::path(*chosen).filename() == "a.ttf");
+
+    // Once b.ttf is gone, sdl2 skips a.ttf and only tries the untested c.otf.
+    std::filesystem::remove(dir / "fonts" / "b.ttf");
+    font_cache::reset();
+    fake_loader third;
+    third.accepted = {"c.otf"};
+    chosen = resolve_with("sdl2", third);
+    assert(chosen && std::filesystem::path(*chosen).filename() == "c.otf");
+    assert(third.tried.size() == 1);
+    font_cache::waitForRevalidation();
+    font_cache::configure("", {});
+    std::filesystem::remove_all(dir);
+}
+
+static void test_revalidation_picks_up_new_fonts()
+{
+    std::filesystem::path dir = temp_font_dir();
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir / "fonts");
+    write_file(dir / "fonts" / "a.ttf", "a");
+    std::string index = (dir / "font_index.txt").string();
+    font_cache::configure(index, {(dir / "fonts").string()});
+
+    fake_loader loader;
+    loader.accepted = {"a.ttf", "d.ttf"};
+    assert(resolve_with("sdl2", loader));
+
+    // Answered from the index: the background pass records the new file
+    // and notices the changed one.
+    write_file(dir / "fonts" / "d.ttf", "d");
+    write_file(dir / "fonts" / "a.ttf", "a, but longer");
+    font_cache::reset();
+    assert(resolve_with("sdl2", loader));
+    font_cache::waitForRevalidation();
+    std::string saved = read_file(index);
+    assert(saved.find("d.ttf") != std::string::npos);
+    assert(saved.find("13 sdl2=1") != std::string::npos);
+
+    // A corrupt index is ignored and rebuilt.
+    write_file(index, "garbage\n");
+    font_cache::reset();
+    assert(resolve_with("sdl2", loader));
+    assert(read_file(index).find("nibbler-font-index 1") == 0);
+    font_cache::waitForRevalidation();
+    font_cache::configure("", {});
+    std::filesystem::remove_all(dir);
+}
+
+// Each plugin library keeps its own copy of the index in memory; a save
+// from one must not drop what the other wrote in the meantime.
+static void test_save_keeps_other_consumers_results()
+{
+    std::filesystem::path dir = temp_font_dir();
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir / "fonts");
+    write_file(dir / "fonts" / "a.ttf", "a");
+    write_file(dir / "fonts" / "b.ttf", "b");
+    std::string index = (dir / "font_index.txt").string();
+    font_cache::configure(index, {(dir / "fonts").string()});
+
+    fake_loader first;
+    first.accepted = {"a.ttf"};
+    assert(resolve_with("sdl2", first));
+
+    // The other plugin's copy never saw sdl2 and saved its own result.
+    std::string other = read_file(index);
+    size_t at = other.find("sdl2=1");
+    assert(at != std::string::npos);
+    other.replace(at, 6, "opengl=1");
+    write_file(index, other);
+
+    fake_loader second;
+    second.accepted = {"b.ttf"};
+    assert(resolve_with("raylib", second));
+    font_cache::waitForRevalidation();
+    std::string saved = read_file(index);
+    assert(saved.find("opengl=1,raylib=0,sdl2=1") != std::string::npos);
+    assert(saved.find("raylib=1") != std::string::npos);
+
+    // Nothing is left behind from the write
+    for (const auto &entry : std::filesystem::directory_iterator(dir))
+    {
+        std::string name = entry.path().filename().string();
+        assert(name == "fonts" || name == "font_index.txt" || name == "font_index.txt.lock");
+    }
+    font_cache::configure("", {});
+    std::filesystem::remove_all(dir);
+}
+
+int main()
+{
+    test_index_skips_rejected_fonts();
+    test_revalidation_picks_up_new_fonts();
+    test_save_keeps_other_consumers_results();
+    std::cout << "Font index tests passed" << std::endl;
+    return 0;
+}
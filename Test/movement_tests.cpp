@@ -1,7 +1,9 @@
 #include "../game_data.hpp"
+#include "../RenderSnapshot.hpp"
 
 #include <cassert>
 #include <chrono>
+#include <cmath>
 #include <iostream>
 
 static void clear_board(game_data &data)
@@ -95,6 +97,490 @@ static void test_high_length_snake_moves()
     std::cout << "High length movement test duration: " << duration.count() << "ms\n";
 }
 
+static void expect_contiguous_segments(const game_data &data, int head_x, int row, int length)
+{
+    for (int index = 0; index < length; ++index)
+    {
+        int x = (head_x - index + static_cast<int>(data.get_width())) %
+                static_cast<int>(data.get_width());
+        int value = data.get_map_value(x, row, 2);
+        if (value != SNAKE_HEAD_PLAYER_1 + index)
+            std::cerr << "segment " << index << " expected " << SNAKE_HEAD_PLAYER_1 + index
+                      << " but found " << value << '\n';
+        assert(value == SNAKE_HEAD_PLAYER_1 + index);
+    }
+    assert(data.get_map_value(head_x, row, 2) % 1000000 == 1);
+}
+
+static void test_segment_sequence_wraps_ring()
+{
+    const int width = 12;
+    const int height = 3;
+    const int row = 1;
+    const int snakeLength = 5;
+
+    game_data data(width, height);
+    clear_board(data);
+    data.set_wrap_around_edges(1);
+
+    int head_x = snakeLength - 1;
+    for (int i = 0; i < snakeLength; ++i)
+        data.set_map_value(head_x - i, row, 2, SNAKE_HEAD_PLAYER_1 + i);
+    data.set_player_snake_length(0, snakeLength);
+    data.sync_snake_segments_from_map();
+    data.set_direction_moving(0, DIRECTION_RIGHT);
+
+    // Run past the ring size so the stored sequence numbers wrap around.
+    const int movesToRun = SNAKE_SEGMENT_RING + 17;
+    double step = 1.0 / data.get_moves_per_second();
+    for (int i = 0; i < movesToRun; ++i)
+        assert(data.update_game_map(step) == 0);
+
+    head_x = (head_x + movesToRun) % width;
+    assert(data.get_snake_length(0) == snakeLength);
+    t_coordinates head = data.get_head_coordinate(SNAKE_HEAD_PLAYER_1);
+    assert(head.x == head_x && head.y == row);
+    expect_contiguous_segments(data, head_x, row, snakeLength);
+
+    // Growing must keep indices contiguous and leave the new tail valid.
+    int food_x = (head_x + 1) % width;
+    data.set_map_value(food_x, row, 2, FOOD);
+    assert(data.update_game_map(step) == 0);
+    assert(data.get_snake_length(0) == snakeLength + 1);
+    expect_contiguous_segments(data, food_x, row, snakeLength + 1);
+
+    // A map resync must reproduce the same public values.
+    data.sync_snake_segments_from_map();
+    expect_contiguous_segments(data, food_x, row, snakeLength + 1);
+}
+
+static void test_map_value_compatibility_shim()
+{
+    game_data data(6, 4);
+    clear_board(data);
+
+    data.set_map_value(1, 1, 0, GAME_TILE_ICE);
+    data.set_map_value(1, 1, 2, FROSTY_FOOD);
+    assert(data.get_map_value(1, 1, 0) == GAME_TILE_ICE);
+    assert(data.get_map_value(1, 1, 2) == FROSTY_FOOD);
+
+    // Snake values replace items and read back with the public encoding.
+    data.set_map_value(1, 1, 2, SNAKE_HEAD_PLAYER_3 + 2);
+    assert(data.get_map_value(1, 1, 2) == SNAKE_HEAD_PLAYER_3 + 2);
+    data.set_map_value(1, 1, 2, 0);
+    assert(data.get_map_value(1, 1, 2) == 0);
+    assert(data.get_map_value(1, 1, 0) == GAME_TILE_ICE);
+
+    // Layer 1 is not stored and out-of-range reads are harmless.
+    data.set_map_value(2, 2, 1, 42);
+    assert(data.get_map_value(2, 2, 1) == 0);
+    assert(data.get_map_value(-1, 0, 0) == 0);
+    assert(data.get_map_value(6, 0, 2) == 0);
+}
+
+static void test_board_stats_track_writes()
+{
+    game_data data(8, 5);
+    clear_board(data);
+
+    const t_board_stats &stats = data.get_board_stats();
+    assert(stats.open_tiles == 40 && stats.wall_tiles == 0);
+
+    place_wall(data, 0, 0);
+    place_wall(data, 1, 0);
+    data.set_map_value(2, 2, 0, GAME_TILE_ICE);
+    data.set_map_value(3, 3, 0, GAME_TILE_FIRE);
+    assert(stats.wall_tiles == 2 && stats.open_tiles == 38);
+    assert(stats.ice_tiles == 1 && stats.fire_tiles == 1);
+
+    // Rewriting a tile with the same value must not double count.
+    place_wall(data, 1, 0);
+    data.set_map_value(1, 0, 0, GAME_TILE_ICE);
+    assert(stats.wall_tiles == 1 && stats.open_tiles == 39 && stats.ice_tiles == 2);
+
+    const int row = 2;
+    for (int i = 0; i < 3; ++i)
+        data.set_map_value(6 - i, row, 2, SNAKE_HEAD_PLAYER_1 + i);
+    data.set_player_snake_length(0, 3);
+    data.sync_snake_segments_from_map();
+    assert(stats.snake_tiles == 3);
+
+    // A plain move keeps occupancy, eating grows it, items never count.
+    data.set_map_value(0, 4, 2, FOOD);
+    data.set_direction_moving(0, DIRECTION_RIGHT);
+    double step = 1.0 / data.get_moves_per_second();
+    assert(data.update_game_map(step) == 0);
+    assert(stats.snake_tiles == 3);
+    data.set_map_value(0, row, 2, FOOD);
+    data.set_wrap_around_edges(1);
+    assert(data.update_game_map(step) == 0);
+    assert(stats.snake_tiles == 4);
+
+    data.reset_board();
+    assert(stats.open_tiles == 40 && stats.wall_tiles == 0 && stats.fire_tiles == 0);
+    assert(stats.snake_tiles == static_cast<size_t>(data.get_snake_length(0)));
+    data.resize_board(3, 3);
+    assert(data.get_board_stats().open_tiles == 9);
+}
+
+static void test_neighbor_table_invalidation()
+{
+    game_data data(6, 4);
+    clear_board(data);
+    for (int x = 0; x < 6; ++x)
+    {
+        place_wall(data, x, 0);
+        place_wall(data, x, 3);
+    }
+    place_head(data, SNAKE_HEAD_PLAYER_1, 2, 1);
+    data.set_player_snake_length(0, 1);
+    data.set_direction_moving(0, DIRECTION_UP);
+
+    // Without wrapping the boundary wall blocks the move.
+    assert(data.test_is_valid_move(SNAKE_HEAD_PLAYER_1) == 1);
+
+    // Toggling wrap must invalidate cached targets: the head passes
+    // through both boundary walls to row 2.
+    data.set_wrap_around_edges(1);
+    assert(data.test_is_valid_move(SNAKE_HEAD_PLAYER_1) == 0);
+    double step = 1.0 / data.get_moves_per_second();
+    assert(data.update_game_map(step) == 0);
+    t_coordinates head = data.get_head_coordinate(SNAKE_HEAD_PLAYER_1);
+    assert(head.x == 2 && head.y == 2);
+
+    // New walls must be picked up as well.
+    assert(data.test_is_valid_move(SNAKE_HEAD_PLAYER_1) == 0);
+    place_wall(data, 2, 1);
+    assert(data.test_is_valid_move(SNAKE_HEAD_PLAYER_1) == 1);
+    ensure_empty(data, 2, 1);
+    assert(data.test_is_valid_move(SNAKE_HEAD_PLAYER_1) == 0);
+
+    // Fire tiles do not change targets.
+    data.set_map_value(2, 1, 0, GAME_TILE_FIRE);
+    assert(data.test_is_valid_move(SNAKE_HEAD_PLAYER_1) == 0);
+}
+
+static void setup_facing_snakes(game_data &data, int simultaneous)
+{
+    clear_board(data);
+    data.set_simultaneous_moves(simultaneous);
+    data.set_map_value(1, 1, 2, SNAKE_HEAD_PLAYER_1);
+    data.set_map_value(3, 1, 2, SNAKE_HEAD_PLAYER_2);
+    data.set_player_snake_length(0, 1);
+    data.set_player_snake_length(1, 1);
+    data.sync_snake_segments_from_map();
+}
+
+static void test_simultaneous_moves_resolve_conflicts()
+{
+    game_data data(7, 3);
+    double step = 1.0 / data.get_moves_per_second();
+
+    // Sequential mode lets player 1 take the contested cell.
+    setup_facing_snakes(data, 0);
+    data.set_direction_moving(0, DIRECTION_RIGHT);
+    data.set_direction_moving(1, DIRECTION_LEFT);
+    assert(data.update_game_map(step) == 1);
+    assert(data.get_head_coordinate(SNAKE_HEAD_PLAYER_1).x == 2);
+    assert(data.get_head_coordinate(SNAKE_HEAD_PLAYER_2).x == 3);
+
+    // Simultaneous mode: both heads entering the same cell collide.
+    setup_facing_snakes(data, 1);
+    data.set_direction_moving(0, DIRECTION_RIGHT);
+    data.set_direction_moving(1, DIRECTION_LEFT);
+    assert(data.update_game_map(step) == 1);
+    assert(data.get_head_coordinate(SNAKE_HEAD_PLAYER_1).x == 1);
+    assert(data.get_head_coordinate(SNAKE_HEAD_PLAYER_2).x == 3);
+
+    // Swapping places collides as well, even though a lone head is also
+    // its own tail.
+    clear_board(data);
+    data.set_map_value(2, 1, 2, SNAKE_HEAD_PLAYER_1);
+    data.set_map_value(3, 1, 2, SNAKE_HEAD_PLAYER_2);
+    data.sync_snake_segments_from_map();
+    data.set_direction_moving(0, DIRECTION_RIGHT);
+    data.set_direction_moving(1, DIRECTION_LEFT);
+    assert(data.update_game_map(step) == 1);
+    assert(data.get_head_coordinate(SNAKE_HEAD_PLAYER_1).x == 2);
+
+    // Independent moves are all committed in the same step.
+    setup_facing_snakes(data, 1);
+    data.set_direction_moving(0, DIRECTION_DOWN);
+    data.set_direction_moving(1, DIRECTION_UP);
+    assert(data.update_game_map(step) == 0);
+    t_coordinates first = data.get_head_coordinate(SNAKE_HEAD_PLAYER_1);
+    t_coordinates second = data.get_head_coordinate(SNAKE_HEAD_PLAYER_2);
+    assert(first.x == 1 && first.y == 2);
+    assert(second.x == 3 && second.y == 0);
+}
+
+// Players 1 and 2 both eat in the same step while player 3 enters the
+// only free cell. The food they earn is placed after all three moves, so it
+// goes to the cell player 3 left rather than the one it is entering.
+static void test_simultaneous_spawns_follow_all_moves()
+{
+    game_data data(7, 3);
+    double step = 1.0 / data.get_moves_per_second();
+    clear_board(data);
+    data.set_simultaneous_moves(1);
+    data.set_additional_food_items(0);
+    for (int x = 0; x < 7; ++x)
+    {
+        place_wall(data, x, 0);
+        place_wall(data, x, 2);
+    }
+    place_wall(data, 2, 1);
+    data.set_map_value(0, 1, 2, SNAKE_HEAD_PLAYER_1);
+    data.set_map_value(1, 1, 2, FOOD);
+    data.set_map_value(3, 1, 2, SNAKE_HEAD_PLAYER_3);
+    data.set_map_value(5, 1, 2, FOOD);
+    data.set_map_value(6, 1, 2, SNAKE_HEAD_PLAYER_2);
+    data.set_player_snake_length(0, 1);
+    data.set_player_snake_length(1, 1);
+    data.set_player_snake_length(2, 1);
+    data.sync_snake_segments_from_map();
+    data.rebuild_empty_cells();
+
+    data.set_direction_moving(0, DIRECTION_RIGHT);
+    data.set_direction_moving(1, DIRECTION_LEFT);
+    data.set_direction_moving(2, DIRECTION_RIGHT);
+    assert(data.update_game_map(step) == 0);
+    assert(data.get_snake_length(0) == 2);
+    assert(data.get_snake_length(1) == 2);
+    assert(data.get_snake_length(2) == 1);
+    assert(data.get_head_coordinate(SNAKE_HEAD_PLAYER_3).x == 4);
+    assert(data.get_map_value(3, 1, 2) == FOOD);
+}
+
+static bool dirty_contains(const game_data &data, size_t cell)
+{
+    for (uint32_t dirty : data.get_dirty_cells())
+    {
+        if (dirty == cell)
+            return (true);
+    }
+    return (false);
+}
+
+static void test_dirty_cells_track_moves()
+{
+    game_data data(6, 3);
+    clear_board(data);
+    data.set_map_value(2, 1, 2, SNAKE_HEAD_PLAYER_1);
+    data.set_map_value(1, 1, 2, SNAKE_HEAD_PLAYER_1 + 1);
+    data.set_player_snake_length(0, 2);
+    data.sync_snake_segments_from_map();
+    assert(data.is_full_redraw_needed());
+
+    data.acknowledge_dirty_cells();
+    assert(!data.is_full_redraw_needed());
+    assert(data.get_dirty_cells().empty());
+    uint64_t generation = data.get_board_generation();
+
+    // One step touches the new head, the old head and the vacated tail.
+    data.set_direction_moving(0, DIRECTION_RIGHT);
+    assert(data.update_game_map(1.0 / data.get_moves_per_second()) == 0);
+    assert(data.get_board_generation() > generation);
+    assert(data.get_dirty_cells().size() == 3);
+    assert(dirty_contains(data, 1 * 6 + 3));
+    assert(dirty_contains(data, 1 * 6 + 2));
+    assert(dirty_contains(data, 1 * 6 + 1));
+
+    data.acknowledge_dirty_cells();
+    generation = data.get_board_generation();
+    data.set_map_value(4, 0, 0, GAME_TILE_WALL);
+    data.set_map_value(4, 0, 0, GAME_TILE_WALL);
+    assert(data.get_dirty_cells().size() == 1);
+    assert(data.get_board_generation() > generation);
+
+    data.request_full_redraw();
+    assert(data.is_full_redraw_needed());
+    assert(data.get_dirty_cells().empty());
+}
+
+static void test_dirty_cells_overflow_to_full_redraw()
+{
+    game_data data(30, 30);
+    clear_board(data);
+    data.acknowledge_dirty_cells();
+
+    size_t changed = 0;
+    for (int y = 0; y < 30 && changed <= DIRTY_CELL_LIMIT; ++y)
+    {
+        for (int x = 0; x < 30 && changed <= DIRTY_CELL_LIMIT; ++x, ++changed)
+            data.set_map_value(x, y, 0, GAME_TILE_ICE);
+    }
+    assert(data.is_full_redraw_needed());
+    assert(data.get_dirty_cells().empty());
+
+    // Back to a list once the renderer caught up
+    data.acknowledge_dirty_cells();
+    data.set_map_value(0, 0, 0, GAME_TILE_EMPTY);
+    assert(!data.is_full_redraw_needed());
+    assert(data.get_dirty_cells().size() == 1);
+}
+
+static void test_render_snapshot_classifies_tiles()
+{
+    game_data data(6, 3);
+    clear_board(data);
+    data.set_map_value(2, 1, 2, SNAKE_HEAD_PLAYER_1);
+    data.set_map_value(1, 1, 2, SNAKE_HEAD_PLAYER_1 + 1);
+    data.set_player_snake_length(0, 2);
+    data.sync_snake_segments_from_map();
+    data.set_map_value(4, 1, 2, FIRE_FOOD);
+    data.set_map_value(0, 0, 0, GAME_TILE_WALL);
+    data.set_map_value(5, 2, 0, GAME_TILE_ICE);
+
+    RenderSnapshot snapshot;
+    data.build_render_snapshot(snapshot);
+    assert(snapshot.width == 6 && snapshot.height == 3);
+    assert(snapshot.tiles.size() == 18);
+    assert(snapshot.generation == data.get_board_generation());
+    assert(snapshot.at(2, 1) == RenderTile::TILE_SNAKE_HEAD);
+    assert(snapshot.at(1, 1) == RenderTile::TILE_SNAKE_BODY);
+    assert(snapshot.at(4, 1) == RenderTile::TILE_FIRE_FOOD);
+    assert(snapshot.at(0, 0) == RenderTile::TILE_WALL);
+    assert(snapshot.at(5, 2) == RenderTile::TILE_ICE);
+    assert(snapshot.at(3, 2) == RenderTile::TILE_EMPTY);
+    assert(snapshot.heads[0].x == 2 && snapshot.heads[0].y == 1);
+    assert(snapshot.heads[1].x == -1);
+    assert(snapshot.snakeLength[0] == 2);
+    assert(snapshot.source == &data);
+
+    // After a move the old head reads as body and the tail cell is free.
+    data.set_direction_moving(0, DIRECTION_RIGHT);
+    assert(data.update_game_map(1.0 / data.get_moves_per_second()) == 0);
+    data.build_render_snapshot(snapshot);
+    assert(snapshot.at(3, 1) == RenderTile::TILE_SNAKE_HEAD);
+    assert(snapshot.at(2, 1) == RenderTile::TILE_SNAKE_BODY);
+    assert(snapshot.at(1, 1) == RenderTile::TILE_EMPTY);
+    assert(snapshot.heads[0].x == 3);
+}
+
+static void test_queued_turns_apply_one_per_move()
+{
+    game_data data(10, 10);
+    data.reset_board();
+    t_coordinates start = data.get_head_coordinate(SNAKE_HEAD_PLAYER_1);
+    double step = 1.0 / data.get_moves_per_second();
+
+    // Not moving yet: the first turn applies at once
+    data.queue_direction(0, DIRECTION_RIGHT);
+    assert(data.get_direction_moving(0) == DIRECTION_RIGHT);
+    assert(data.get_queued_turns(0) == 0);
+
+    // Up then left within one move: both survive, one per move. Repeats
+    // and reversals of the previous turn are not queued.
+    data.queue_direction(0, DIRECTION_UP);
+    data.queue_direction(0, DIRECTION_UP);
+    data.queue_direction(0, DIRECTION_DOWN);
+    data.queue_direction(0, DIRECTION_LEFT);
+    assert(data.get_queued_turns(0) == 2);
+    assert(data.update_game_map(step) == 0);
+    t_coordinates head = data.get_head_coordinate(SNAKE_HEAD_PLAYER_1);
+    assert(head.x == start.x && head.y == start.y - 1);
+    assert(data.update_game_map(step) == 0);
+    head = data.get_head_coordinate(SNAKE_HEAD_PLAYER_1);
+    assert(head.x == start.x - 1 && head.y == start.y - 1);
+    assert(data.get_queued_turns(0) == 0);
+
+    // A full buffer refuses a turn reversing the one it would follow
+    data.queue_direction(0, DIRECTION_DOWN);
+    data.queue_direction(0, DIRECTION_RIGHT);
+    data.queue_direction(0, DIRECTION_UP);
+    data.queue_direction(0, DIRECTION_LEFT);
+    assert(data.get_queued_turns(0) == TURN_BUFFER_SIZE);
+
+    data.reset_board();
+    assert(data.get_queued_turns(0) == 0);
+}
+
+static void expect_turns(game_data &data, const int *directions, int count)
+{
+    double step = 1.0 / data.get_moves_per_second();
+    for (int i = 0; i < count; ++i)
+    {
+        assert(data.update_game_map(step) == 0);
+        assert(data.get_direction_moving(0) == directions[i]);
+    }
+    assert(data.get_queued_turns(0) == 0);
+}
+
+static void test_full_turn_buffer_replaces_last_turn()
+{
+    game_data data(10, 10);
+    clear_board(data);
+    data.set_map_value(5, 5, 2, SNAKE_HEAD_PLAYER_1);
+    data.set_map_value(6, 5, 2, SNAKE_HEAD_PLAYER_1 + 1);
+    data.set_player_snake_length(0, 2);
+    data.sync_snake_segments_from_map();
+    data.set_direction_moving(0, DIRECTION_LEFT);
+
+    // Left would follow right once it replaced up, so it is dropped
+    data.queue_direction(0, DIRECTION_DOWN);
+    data.queue_direction(0, DIRECTION_RIGHT);
+    data.queue_direction(0, DIRECTION_UP);
+    data.queue_direction(0, DIRECTION_LEFT);
+    const int kept[3] = {DIRECTION_DOWN, DIRECTION_RIGHT, DIRECTION_UP};
+    expect_turns(data, kept, 3);
+
+    // Right reverses the left it replaces but not the down it follows
+    data.queue_direction(0, DIRECTION_LEFT);
+    data.queue_direction(0, DIRECTION_DOWN);
+    data.queue_direction(0, DIRECTION_LEFT);
+    data.queue_direction(0, DIRECTION_RIGHT);
+    const int replaced[3] = {DIRECTION_LEFT, DIRECTION_DOWN, DIRECTION_RIGHT};
+    expect_turns(data, replaced, 3);
+}
+
+static void test_move_phase_tracks_update_timer()
+{
+    game_data data(10, 10);
+    data.set_moves_per_second(4.0);
+    data.reset_board();
+    RenderSnapshot snapshot;
+
+    // A snake that is not moving yet stays at phase 0
+    data.update_game_map(0.1);
+    data.build_render_snapshot(snapshot);
+    assert(!(snapshot.movePhase[0] > 0.0f));
+
+    data.set_direction_moving(0, DIRECTION_RIGHT);
+    data.update_game_map(0.25);
+    data.build_render_snapshot(snapshot);
+    assert(std::fabs(snapshot.movePhase[0] - 0.4f) < 1e-5f);
+    assert(!(snapshot.movePhase[1] > 0.0f));
+
+    // Banked time that has not been ticked yet counts too, up to 1
+    data.fill_move_phase(snapshot, 0.05);
+    assert(std::fabs(snapshot.movePhase[0] - 0.6f) < 1e-5f);
+    data.fill_move_phase(snapshot, 1.0);
+    assert(snapshot.movePhase[0] >= 1.0f && snapshot.movePhase[0] <= 1.0f);
+}
+
+static void test_snake_body_keeps_order_while_growing()
+{
+    snake_body body;
+    body.reserve(4);
+    // Wrap the ring before it has to grow
+    for (int i = 0; i < 10; ++i)
+    {
+        body.push_front((t_coordinates){i, 0});
+        if (body.size() > 3)
+            body.pop_back();
+    }
+    for (int i = 10; i < 40; ++i)
+        body.push_front((t_coordinates){i, 0});
+    body.push_back((t_coordinates){-1, 0});
+    assert(body.size() == 34);
+    for (size_t i = 0; i < body.size(); ++i)
+        assert(body[i].x == 39 - static_cast<int>(i) || (i == 33 && body[i].x == -1));
+    assert(body.front().x == 39 && body.back().x == -1);
+    body.clear();
+    assert(body.empty());
+}
+
 int main()
 {
     game_data data(5, 5);
@@ -125,6 +611,19 @@ int main()
     expect_valid_move(data, SNAKE_HEAD_PLAYER_4, "player 4 move");
 
     test_high_length_snake_moves();
+    test_segment_sequence_wraps_ring();
+    test_map_value_compatibility_shim();
+    test_board_stats_track_writes();
+    test_neighbor_table_invalidation();
+    test_simultaneous_moves_resolve_conflicts();
+    test_simultaneous_spawns_follow_all_moves();
+    test_dirty_cells_track_moves();
+    test_dirty_cells_overflow_to_full_redraw();
+    test_render_snapshot_classifies_tiles();
+    test_queued_turns_apply_one_per_move();
+    test_full_turn_buffer_replaces_last_turn();
+    test_snake_body_keeps_order_while_growing();
+    test_move_phase_tracks_update_timer();
 
     std::cout << "Movement tests passed" << std::endl;
     return 0;
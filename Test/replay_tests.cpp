@@ -0,0 +1,163 @@
+#include "../replay_log.hpp"
+#include "../game_data.hpp"
+
+#include <cassert>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <unistd.h>
+
+// Per process, so concurrent test runs do not share a log
+static std::string temp_log_path()
+{
+    std::string name = "nibbler_replay_test_" + std::to_string(getpid()) + ".log";
+    return ((std::filesystem::temp_directory_path() / name).string());
+}
+
+// Plays a scripted session with changing step sizes and records it.
+static uint64_t record_session(const std::string &path)
+{
+    static const int turns[4] = {DIRECTION_UP, DIRECTION_LEFT, DIRECTION_DOWN, DIRECTION_RIGHT};
+    static const double steps[3] = {1.0, 0.5, 0.25};
+
+    game_data data(15, 12);
+    data.set_wrap_around_edges(1);
+    data.set_additional_food_items(1);
+    data.reset_board();
+
+    replay_recorder recorder;
+    assert(recorder.begin(data, path.c_str()) == 0);
+    uint64_t ticks = 0;
+    for (int i = 0; i < 600; ++i)
+    {
+        if (i % 7 == 0)
+        {
+            int direction = turns[(i / 7) % 4];
+            data.set_direction_moving(0, direction);
+            recorder.record_direction(0, direction);
+        }
+        double step = steps[(i / 50) % 3];
+        recorder.record_step(step);
+        ++ticks;
+        if (data.update_game_map(step))
+            break;
+    }
+    assert(recorder.end(data) == 0);
+    assert(!recorder.is_recording());
+    return (ticks);
+}
+
+// Same as record_session, but steering through the turn buffer the way
+// the engine does, with several turns between moves.
+static uint64_t record_turn_session(const std::string &path)
+{
+    static const int turns[4] = {DIRECTION_UP, DIRECTION_LEFT, DIRECTION_DOWN, DIRECTION_RIGHT};
+
+    game_data data(15, 12);
+    data.set_wrap_around_edges(1);
+    data.reset_board();
+
+    replay_recorder recorder;
+    assert(recorder.begin(data, path.c_str()) == 0);
+    uint64_t ticks = 0;
+    for (int i = 0; i < 400; ++i)
+    {
+        if (i % 5 == 0)
+        {
+            int direction = turns[(i / 5) % 4];
+            data.queue_direction(0, direction);
+            recorder.record_turn(0, direction);
+        }
+        recorder.record_step(0.25);
+        ++ticks;
+        if (data.update_game_map(0.25))
+            break;
+    }
+    assert(recorder.end(data) == 0);
+    return (ticks);
+}
+
+static void test_replay_matches_recording()
+{
+    std::string path = temp_log_path();
+    uint64_t ticks = record_session(path);
+
+    replay_report report;
+    assert(replay_run_headless(path.c_str(), report) == 0);
+    assert(report.ticks == ticks);
+    assert(report.desync == 0);
+
+    // Only step size changes are stored, not one record per tick.
+    replay_log log;
+    assert(replay_load(path.c_str(), log) == 0);
+    size_t step_records = 0;
+    for (const replay_event &event : log.events)
+    {
+        if (event.type == REPLAY_EVENT_STEP)
+            ++step_records;
+    }
+    assert(step_records <= 13);
+    assert(log.events.back().type == REPLAY_EVENT_END);
+    assert(log.events.back().tick == ticks);
+
+    ticks = record_turn_session(path);
+    assert(replay_run_headless(path.c_str(), report) == 0);
+    assert(report.ticks == ticks);
+    assert(report.desync == 0);
+    std::filesystem::remove(path);
+}
+
+static void test_replay_detects_desync()
+{
+    std::string path = temp_log_path();
+    record_session(path);
+
+    replay_log log;
+    assert(replay_load(path.c_str(), log) == 0);
+    for (replay_event &event : log.events)
+    {
+        if (event.type == REPLAY_EVENT_DIRECTION)
+        {
+            event.direction = (event.direction == DIRECTION_UP) ? DIRECTION_RIGHT : DIRECTION_UP;
+            break;
+        }
+    }
+    game_data data(1, 1);
+    replay_player player(log);
+    assert(player.start(data) == 0);
+    assert(static_cast<int>(data.get_width()) == log.header.width);
+    while (player.step(data) != 2)
+        ;
+    assert(player.finished());
+    assert(player.desynced());
+    std::filesystem::remove(path);
+}
+
+static void test_truncated_log_is_rejected()
+{
+    std::string path = temp_log_path();
+    record_session(path);
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 4);
+    replay_log log;
+    assert(replay_load(path.c_str(), log) != 0);
+    assert(replay_load("/nonexistent/nibbler.log", log) != 0);
+    std::filesystem::remove(path);
+}
+
+static void test_game_paths_are_numbered()
+{
+    assert(replay_game_path("session.log", 1) == "session.log");
+    assert(replay_game_path("session.log", 2) == "session-2.log");
+    assert(replay_game_path("runs/session.log", 12) == "runs/session-12.log");
+    assert(replay_game_path("session", 3) == "session-3");
+}
+
+int main()
+{
+    test_replay_matches_recording();
+    test_replay_detects_desync();
+    test_truncated_log_is_rejected();
+    test_game_paths_are_numbered();
+    std::cout << "Replay tests passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,256 @@
+#include "../simulation_runner.hpp"
+#include "../SimulationThread.hpp"
+#include "../replay_log.hpp"
+#include "../game_data.hpp"
+
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+static int scripted_right(game_data &data, int player, ft_rng &rng)
+{
+    (void)rng;
+    if (data.get_direction_moving(player) == DIRECTION_NONE)
+        return (DIRECTION_RIGHT);
+    return (DIRECTION_NONE);
+}
+
+static void test_runner_counts_ticks_across_workers()
+{
+    simulation_config config;
+    simulation_default_config(config);
+    config.width = 12;
+    config.height = 10;
+    config.games = 7;
+    config.ticks_per_game = 200;
+    config.workers = 3;
+    config.seed = 42;
+
+    simulation_report report;
+    assert(run_simulation(config, report) == 0);
+    assert(report.ticks == 7u * 200u);
+    assert(report.elapsed_seconds >= 0.0);
+    assert(report.workers == 3);
+
+    // Never more workers than games
+    config.workers = 16;
+    assert(run_simulation(config, report) == 0);
+    assert(report.workers == 7);
+}
+
+static int policy_calls[4];
+
+static int counting_greedy(game_data &data, int player, ft_rng &rng)
+{
+    ++policy_calls[player];
+    return (simulation_policy_greedy(data, player, rng));
+}
+
+static void test_extra_players_are_seeded()
+{
+    simulation_config config;
+    simulation_default_config(config);
+    config.width = 16;
+    config.height = 12;
+    config.games = 1;
+    config.ticks_per_game = 300;
+    config.workers = 1;
+    config.players = 3;
+    config.simultaneous_moves = 1;
+    config.policy = counting_greedy;
+
+    simulation_report report;
+    assert(run_simulation(config, report) == 0);
+    assert(report.ticks == 300u);
+    assert(policy_calls[0] == 300 && policy_calls[1] == 300 && policy_calls[2] == 300);
+    assert(policy_calls[3] == 0);
+}
+
+static void test_multi_player_start_keeps_food()
+{
+    uint64_t seed = 1;
+    while (seed <= 200)
+    {
+        game_data data(8, 8);
+        data.set_rng_seed(seed);
+        data.reset_board(4);
+        int food = 0;
+        int y = 0;
+        while (y < 8)
+        {
+            int x = 0;
+            while (x < 8)
+            {
+                if (data.get_map_value(x, y, 2) == FOOD)
+                    ++food;
+                ++x;
+            }
+            ++y;
+        }
+        assert(food == 1);
+        int player = 0;
+        while (player < 4)
+        {
+            assert(data.get_snake_length(player) == 4);
+            ++player;
+        }
+        ++seed;
+    }
+}
+
+static void test_scripted_policy_hits_the_wall()
+{
+    simulation_config config;
+    simulation_default_config(config);
+    config.width = 10;
+    config.height = 10;
+    config.games = 2;
+    config.ticks_per_game = 50;
+    config.workers = 2;
+    config.policy = scripted_right;
+
+    // The snake starts in the middle of a 10 wide board, so going straight
+    // right without wrapping ends each game after a handful of ticks.
+    simulation_report report;
+    assert(run_simulation(config, report) == 0);
+    assert(report.ticks == 100u);
+    assert(report.game_overs >= 2u);
+
+    config.wrap_around_edges = 1;
+    assert(run_simulation(config, report) == 0);
+    assert(report.game_overs == 0u);
+}
+
+static void test_runs_are_reproducible_from_seed()
+{
+    simulation_config config;
+    simulation_default_config(config);
+    config.width = 12;
+    config.height = 12;
+    config.games = 6;
+    config.ticks_per_game = 3000;
+    config.seed = 7;
+    config.policy = simulation_policy_random;
+
+    // The outcome must not depend on how games are spread over workers.
+    simulation_report first;
+    simulation_report second;
+    config.workers = 1;
+    assert(run_simulation(config, first) == 0);
+    config.workers = 3;
+    assert(run_simulation(config, second) == 0);
+    assert(first.game_overs == second.game_overs);
+    assert(first.apples_eaten == second.apples_eaten);
+    assert(first.game_overs > 0u);
+}
+
+static void test_invalid_config_is_rejected()
+{
+    simulation_config config;
+    simulation_default_config(config);
+    config.workers = 0;
+    simulation_report report;
+    assert(run_simulation(config, report) == 1);
+
+    simulation_default_config(config);
+    config.players = 5;
+    assert(run_simulation(config, report) == 1);
+    config.players = 4;
+    config.height = 3;
+    assert(run_simulation(config, report) == 1);
+}
+
+static void test_spsc_queue_wraps()
+{
+    SpscQueue<int, 4> queue;
+    int value = 0;
+    assert(!queue.pop(value));
+    for (int round = 0; round < 3; ++round)
+    {
+        for (int i = 0; i < 4; ++i)
+            assert(queue.push(round * 10 + i));
+        assert(!queue.push(99));
+        for (int i = 0; i < 4; ++i)
+        {
+            assert(queue.pop(value));
+            assert(value == round * 10 + i);
+        }
+        assert(!queue.pop(value));
+    }
+}
+
+static void test_snapshot_exchange_hands_over_latest()
+{
+    SnapshotExchange exchange;
+    assert(!exchange.acquire());
+
+    exchange.back().generation = 1;
+    exchange.publish();
+    exchange.back().generation = 2;
+    exchange.publish();
+    assert(exchange.acquire());
+    assert(exchange.front().generation == 2);
+    assert(!exchange.acquire());
+
+    // The writer never gets the slot the reader holds
+    exchange.back().generation = 3;
+    exchange.publish();
+    assert(exchange.front().generation == 2);
+    assert(exchange.acquire());
+    assert(exchange.front().generation == 3);
+}
+
+static void test_simulation_thread_runs_until_game_over()
+{
+    game_data data(10, 10);
+    data.set_rng_seed(3);
+    data.reset_board();
+    data.set_moves_per_second(60.0);
+    data.set_direction_moving(0, DIRECTION_RIGHT);
+    replay_recorder recorder;
+
+    SimulationThread thread;
+    assert(thread.start(data, recorder, 240, 8, 1.0) == 0);
+    assert(thread.isRunning());
+    assert(thread.acquireSnapshot());
+    assert(thread.snapshot().source == nullptr);
+    assert(thread.snapshot().width == 10);
+    assert(thread.snapshot().fullRedraw);
+    assert(thread.snapshot().movePhase[0] >= 0.0f && thread.snapshot().movePhase[0] <= 1.0f);
+
+    // Heading straight into the right wall ends the game well within a second
+    for (int i = 0; i < 200 && !thread.isGameOver(); ++i)
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    assert(thread.isGameOver());
+    assert(thread.acquireSnapshot());
+    uint64_t last = thread.snapshot().generation;
+    thread.stop();
+    assert(!thread.isRunning());
+    assert(last == data.get_board_generation());
+
+    // Steering reaches the board through the queue
+    data.reset_board();
+    data.set_direction_moving(0, DIRECTION_RIGHT);
+    assert(thread.start(data, recorder, 240, 8, 1.0) == 0);
+    assert(thread.pushDirection(0, DIRECTION_UP));
+    for (int i = 0; i < 200 && !thread.isGameOver(); ++i)
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    thread.stop();
+    assert(data.get_direction_moving(0) == DIRECTION_UP);
+}
+
+int main()
+{
+    test_runner_counts_ticks_across_workers();
+    test_scripted_policy_hits_the_wall();
+    test_runs_are_reproducible_from_seed();
+    test_extra_players_are_seeded();
+    test_multi_player_start_keeps_food();
+    test_invalid_config_is_rejected();
+    test_spsc_queue_wraps();
+    test_snapshot_exchange_hands_over_latest();
+    test_simulation_thread_runs_until_game_over();
+    std::cout << "Simulation tests passed" << std::endl;
+    return 0;
+}
@@ -8,7 +8,6 @@
 #include <utility>
 #include <unordered_map>
 #include <cctype>
-#include "libft/RNG/RNG.hpp"
 
 std::optional<std::vector<std::string>> read_file_lines(const char *path) {
     if (!path)
@@ -283,7 +282,7 @@ int load_rules_into_game_data(game_data &data, const game_rules &rules) {
             }
         }
         if (!empties.empty()) {
-            int idx = ft_dice_roll(1, static_cast<int>(empties.size())) - 1;
+            int idx = data.get_rng().dice_roll(1, static_cast<int>(empties.size())) - 1;
             int fx = empties[idx].first;
             int fy = empties[idx].second;
             data.set_map_value(fx, fy, 2, FOOD);
@@ -301,7 +300,7 @@ int load_rules_into_game_data(game_data &data, const game_rules &rules) {
                 }
             }
             if (!empties2.empty()) {
-                int idx2 = ft_dice_roll(1, static_cast<int>(empties2.size())) - 1;
+                int idx2 = data.get_rng().dice_roll(1, static_cast<int>(empties2.size())) - 1;
                 int fx2 = empties2[idx2].first;
                 int fy2 = empties2[idx2].second;
                 data.set_map_value(fx2, fy2, 0, GAME_TILE_FIRE);
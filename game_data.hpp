@@ -2,11 +2,12 @@
 #define GAME_DATA_HPP
 
 #include "libft/Game/character.hpp"
-#include "libft/Game/map3d.hpp"
 #include "libft/CPP_class/string_class.hpp"
+#include "libft/RNG/ft_rng.hpp"
+#include <algorithm>
 #include <vector>
 #include <string>
-#include <deque>
+#include <cstdint>
 
 #define GAME_TILE_EMPTY 0
 #define GAME_TILE_WALL 1
@@ -39,6 +40,22 @@ enum : char {
 #define FAILURE 1
 
 static const int MAX_SNAKE_LENGTH = 40000;
+// Snake cells store a per-player ring sequence number instead of their
+// index, so a move only rewrites the new head and the vacated tail. The ring
+// must be larger than MAX_SNAKE_LENGTH to keep indices unambiguous and fits
+// the 16-bit segment plane.
+static const int SNAKE_SEGMENT_RING = 65536;
+// Turns pressed faster than the snake moves are kept and applied one per
+// move instead of overwriting each other.
+static const int TURN_BUFFER_SIZE = 3;
+// Most cells listed as dirty between two acknowledgements. Past it the
+// list is dropped for a full redraw, which costs a renderer about as much
+// and keeps the list from growing with the board.
+static const size_t DIRTY_CELL_LIMIT = 256;
+// Segments each snake body holds before its first growth. Bodies keep
+// their storage across resets, so a running game moves without
+// allocating.
+static const size_t SNAKE_BODY_RESERVE = 1024;
 #define FOOD 1
 #define FIRE_FOOD 2
 #define FROSTY_FOOD 3
@@ -53,16 +70,73 @@ static const int MAX_SNAKE_LENGTH = 40000;
 #define ACH_TILE_FIRE_STEPS 7
 #define ACH_GOAL_PRIMARY 0
 
+struct RenderSnapshot;
+
 typedef struct s_coordinates {
     int x;
     int y;
 } t_coordinates;
 
+// A snake's cells from head (index 0) to tail. Moving pushes the new head
+// and pops the tail inside one ring of storage, which only grows and is
+// never handed back, unlike the chunks of a std::deque.
+class snake_body
+{
+    public:
+        snake_body();
+
+        bool                 empty() const;
+        size_t               size() const;
+        const t_coordinates &front() const;
+        const t_coordinates &back() const;
+        const t_coordinates &operator[](size_t index) const;
+        void                 push_front(const t_coordinates &coord);
+        void                 push_back(const t_coordinates &coord);
+        void                 pop_back();
+        void                 clear();
+        void                 reserve(size_t capacity);
+
+    private:
+        std::vector<t_coordinates> _cells;
+        size_t                     _start;
+        size_t                     _count;
+};
+
+// Board-wide tile counts kept up to date on every terrain or occupancy
+// write, so spawning decisions do not need to rescan the board.
+typedef struct s_board_stats {
+    size_t wall_tiles;
+    size_t open_tiles;
+    size_t ice_tiles;
+    size_t fire_tiles;
+    size_t snake_tiles;
+} t_board_stats;
+
+// One resolved step for a player. status is 1 when the move collides;
+// direction is DIRECTION_NONE when the snake stays in place.
+typedef struct s_move_plan {
+    int    player;
+    int    status;
+    int    direction;
+    size_t head_cell;
+    size_t target_cell;
+} t_move_plan;
+
+// Food and fire tiles owed by the moves of one simultaneous step, placed
+// only once every move of the step has been committed.
+typedef struct s_spawn_requests {
+    int food;
+    int fire_tiles;
+} t_spawn_requests;
+
 class game_data
 {
     public:
         game_data(int width, int height);
         void reset_board();
+        // Starts players 1..players-1 as well, on rows spaced
+        // height / players apart, before any food is placed.
+        void reset_board(int players);
         void resize_board(int width, int height);
         void spawn_food();
 
@@ -71,16 +145,44 @@ class game_data
         int  get_wrap_around_edges() const;
         void set_direction_moving(int player, int direction);
         int  get_direction_moving(int player) const;
+        // Buffers a turn to apply at the player's next move. Applies it at
+        // once when the snake is not moving yet.
+        void queue_direction(int player, int direction);
+        int  get_queued_turns(int player) const;
 
         void set_moves_per_second(double moves);
         double get_moves_per_second() const;
         void set_additional_food_items(int value);
         int  get_additional_food_items() const;
+        void set_simultaneous_moves(int value);
+        int  get_simultaneous_moves() const;
+        void     set_rng_seed(uint64_t seed);
+        uint64_t get_rng_seed() const;
+        ft_rng   &get_rng();
 
         void   set_map_value(int x, int y, int layer, int value);
         int    get_map_value(int x, int y, int layer) const;
         size_t get_width() const;
         size_t get_height() const;
+        const t_board_stats &get_board_stats() const;
+
+        // Cells whose rendered content (terrain, item, snake occupancy or
+        // head position) changed since the last acknowledge_dirty_cells().
+        // Body segment indices shifting along a moving snake are not
+        // reported. When is_full_redraw_needed() is true the list is empty
+        // and every cell must be redrawn. The generation counter advances on
+        // every change.
+        const std::vector<uint32_t> &get_dirty_cells() const;
+        bool        is_full_redraw_needed() const;
+        uint64_t    get_board_generation() const;
+        void        acknowledge_dirty_cells();
+        void        request_full_redraw();
+        // Fills snapshot with the current board, heads and HUD counters
+        // in one pass over the board planes. Reuses the tile buffer.
+        void        build_render_snapshot(RenderSnapshot &snapshot) const;
+        // Refreshes only snapshot.movePhase. pending is game time banked
+        // towards the next tick that update_game_map has not seen yet.
+        void        fill_move_phase(RenderSnapshot &snapshot, double pending) const;
 
         void reset_player_status_effects(int player);
 
@@ -106,6 +208,7 @@ class game_data
         int         get_tile_fire_steps() const;
 
         void        sync_snake_segments_from_map();
+        void        rebuild_empty_cells();
 
     // Testing method - exposes private is_valid_move for unit tests
     int test_is_valid_move(int player_head);
@@ -119,10 +222,33 @@ class game_data
         void        apply_snake_segments(int player, const std::vector<t_coordinates> &segments);
         void        rebuild_snake_segments_from_map(int player);
         void        write_snake_to_map(int player);
+        int         allocate_board(int width, int height);
+        bool        is_in_bounds(int x, int y) const;
+        size_t      cell_index(int x, int y) const;
+        bool        is_cell_occupied(size_t cell) const;
+        void        mark_cell_dirty(size_t cell);
+        int         entity_value(size_t cell) const;
+        void        store_entity_value(size_t cell, int value);
+        void        set_segment(size_t cell, int player, int index);
+        void        clear_entity(size_t cell);
+        void        set_terrain(size_t cell, int value);
+        void        reset_board_stats();
+        uint16_t    encode_segment_sequence(int player, int index) const;
+        int         decode_segment_value(int player, uint16_t sequence) const;
 
         int         is_valid_move(int player_head);
         bool        advance_wrap_target(int direction, int &target_x, int &target_y) const;
+        int         compute_neighbor_cell(int x, int y, int direction) const;
+        void        rebuild_neighbor_table();
+        int         neighbor_cell(size_t cell, int direction);
         int         update_snake_position(int player_head);
+        t_move_plan plan_move(int player);
+        int         apply_move(const t_move_plan &plan, t_spawn_requests *deferred);
+        void        resolve_move_conflicts(t_move_plan *plans, int count) const;
+        double      move_interval(int player) const;
+        void        consume_speed_boost(int player);
+        void        apply_queued_turn(int player);
+        int         update_game_map_simultaneous(double deltaTime);
         void        spawn_fire_tile();
         bool        can_spawn_frosty_food(int x, int y);
         bool        is_tile_free(int &x, int &y) const;
@@ -131,21 +257,142 @@ class game_data
         int         _wrap_around_edges;
         int         _amount_players_dead;
         int         _direction_moving[4];
+        int         _turn_buffer[4][TURN_BUFFER_SIZE];
+        int         _turn_count[4];
         int         _direction_moving_ice[4];
         int         _speed_boost_steps[4];
         bool        _fire_boost_active[4];
         int         _frosty_steps[4];
         int         _snake_length[4];
+        int         _snake_head_sequence[4];
         double      _update_timer[4];
         double      _moves_per_second;
         int         _additional_food_items;
+        int         _simultaneous_moves;
         ft_string   _profile_name;
         std::string _map_name;
-        ft_map3d                                _map;
+        // Board planes, one entry per cell in row-major order. Layer 0 of
+        // the public map API maps to _terrain; layer 2 combines _items with
+        // the snake occupancy planes. Layer 1 is not stored.
+        size_t                          _width;
+        size_t                          _height;
+        std::vector<uint8_t>            _terrain;
+        std::vector<uint8_t>            _items;
+        std::vector<uint8_t>            _segment_owner;
+        std::vector<uint16_t>           _segment_sequence;
+        t_board_stats                   _board_stats;
+        // How a move leaves each cell: bit `direction` set when the move is
+        // blocked, bit `4 + direction` when it wraps around the board. Any
+        // other move lands on the adjacent cell. A wrapped target depends
+        // only on the column (up/down) or row (left/right) and is kept in
+        // _wrap_targets[direction], -1 when the line is all wall. Rebuilt
+        // lazily after wall layout or wrap mode changes.
+        std::vector<uint8_t>            _neighbor_flags;
+        std::vector<int>                _wrap_targets[4];
+        bool                            _neighbor_table_dirty;
+        // Cells changed since the renderer last acknowledged, at most
+        // DIRTY_CELL_LIMIT; _dirty_flags keeps each cell in the list once.
+        std::vector<uint32_t>           _dirty_cells;
+        std::vector<uint8_t>            _dirty_flags;
+        bool                            _dirty_full;
+        uint64_t                        _board_generation;
+        uint64_t                        _acknowledged_generation;
         ft_character                            _character;
+        // Drives food and fire placement. Seeded from entropy by default;
+        // set_rng_seed makes a run reproducible.
+        ft_rng                                  _rng;
         std::vector<t_coordinates>      _empty_cells;
         std::vector<int>                _empty_cell_indices;
-        std::deque<t_coordinates>       _snake_segments[4];
+        snake_body                      _snake_segments[4];
 };
 
+inline snake_body::snake_body() : _start(0), _count(0) {
+}
+
+inline bool snake_body::empty() const {
+    return (this->_count == 0);
+}
+
+inline size_t snake_body::size() const {
+    return (this->_count);
+}
+
+inline const t_coordinates &snake_body::front() const {
+    return (this->_cells[this->_start]);
+}
+
+inline const t_coordinates &snake_body::back() const {
+    return ((*this)[this->_count - 1]);
+}
+
+// Capacity is a power of two, so wrapping is a mask.
+inline const t_coordinates &snake_body::operator[](size_t index) const {
+    return (this->_cells[(this->_start + index) & (this->_cells.size() - 1)]);
+}
+
+inline void snake_body::push_front(const t_coordinates &coord) {
+    if (this->_count == this->_cells.size())
+        this->reserve(std::max<size_t>(16, this->_count * 2));
+    this->_start = (this->_start + this->_cells.size() - 1) & (this->_cells.size() - 1);
+    this->_cells[this->_start] = coord;
+    ++this->_count;
+}
+
+inline void snake_body::push_back(const t_coordinates &coord) {
+    if (this->_count == this->_cells.size())
+        this->reserve(std::max<size_t>(16, this->_count * 2));
+    this->_cells[(this->_start + this->_count) & (this->_cells.size() - 1)] = coord;
+    ++this->_count;
+}
+
+inline void snake_body::pop_back() {
+    --this->_count;
+}
+
+inline void snake_body::clear() {
+    this->_start = 0;
+    this->_count = 0;
+}
+
+inline void snake_body::reserve(size_t capacity) {
+    if (capacity <= this->_cells.size())
+        return ;
+    size_t rounded = 16;
+    while (rounded < capacity)
+        rounded *= 2;
+    std::vector<t_coordinates> cells(rounded);
+    size_t index = 0;
+    while (index < this->_count) {
+        cells[index] = (*this)[index];
+        ++index;
+    }
+    this->_cells.swap(cells);
+    this->_start = 0;
+}
+
+inline bool game_data::is_in_bounds(int x, int y) const {
+    return (x >= 0 && y >= 0 && static_cast<size_t>(x) < this->_width &&
+            static_cast<size_t>(y) < this->_height);
+}
+
+inline size_t game_data::cell_index(int x, int y) const {
+    return (static_cast<size_t>(y) * this->_width + static_cast<size_t>(x));
+}
+
+inline bool game_data::is_cell_occupied(size_t cell) const {
+    return (this->_items[cell] != 0 || this->_segment_owner[cell] != 0);
+}
+
+inline void game_data::mark_cell_dirty(size_t cell) {
+    ++this->_board_generation;
+    if (this->_dirty_full || this->_dirty_flags[cell])
+        return ;
+    if (this->_dirty_cells.size() >= DIRTY_CELL_LIMIT) {
+        this->request_full_redraw();
+        return ;
+    }
+    this->_dirty_flags[cell] = 1;
+    this->_dirty_cells.push_back(static_cast<uint32_t>(cell));
+}
+
 #endif // GAME_DATA_HPP
@@ -1,28 +1,230 @@
 #include "game_data.hpp"
-#include "libft/RNG/RNG.hpp"
+#include "RenderSnapshot.hpp"
+#include "libft/Errno/errno.hpp"
 #include <algorithm>
+#include <new>
 
 void game_data::set_map_value(int x, int y, int layer, int value) {
-    int prev_val = this->_map.get(x, y, layer);
-    this->_map.set(x, y, layer, value);
+    if (!this->is_in_bounds(x, y))
+        return;
+    size_t cell = this->cell_index(x, y);
     if (layer == 2) {
-        if (prev_val == 0 && value != 0)
+        bool was_occupied = this->is_cell_occupied(cell);
+        this->store_entity_value(cell, value);
+        if (!was_occupied && value != 0)
             this->remove_empty_cell(x, y);
-        else if (prev_val != 0 && value == 0 &&
-                 this->_map.get(x, y, 0) != GAME_TILE_WALL)
+        else if (was_occupied && value == 0 &&
+                 this->_terrain[cell] != GAME_TILE_WALL)
             this->add_empty_cell(x, y);
     } else if (layer == 0) {
+        int prev_val = this->_terrain[cell];
+        this->set_terrain(cell, value);
         if (value == GAME_TILE_WALL)
             this->remove_empty_cell(x, y);
-        else if (prev_val == GAME_TILE_WALL &&
-                 this->_map.get(x, y, 2) == 0)
+        else if (prev_val == GAME_TILE_WALL && !this->is_cell_occupied(cell))
             this->add_empty_cell(x, y);
     }
     return;
 }
 
 int game_data::get_map_value(int x, int y, int layer) const {
-    return (this->_map.get(x, y, layer));
+    if (!this->is_in_bounds(x, y))
+        return (0);
+    size_t cell = this->cell_index(x, y);
+    if (layer == 0)
+        return (this->_terrain[cell]);
+    if (layer == 2)
+        return (this->entity_value(cell));
+    return (0);
+}
+
+int game_data::entity_value(size_t cell) const {
+    int owner = this->_segment_owner[cell];
+    if (owner != 0)
+        return (this->decode_segment_value(owner - 1, this->_segment_sequence[cell]));
+    return (this->_items[cell]);
+}
+
+// Accepts the public layer 2 encoding: 0, an item id, or a snake value of
+// (player + 1) * 1000000 + 1-based segment index.
+void game_data::store_entity_value(size_t cell, int value) {
+    int player = (value / 1000000) - 1;
+    if (player >= 0 && player < 4) {
+        this->set_segment(cell, player, value - (player + 1) * 1000000);
+        return;
+    }
+    this->clear_entity(cell);
+    this->_items[cell] = static_cast<uint8_t>(value);
+    this->mark_cell_dirty(cell);
+    return;
+}
+
+void game_data::set_segment(size_t cell, int player, int index) {
+    this->_items[cell] = 0;
+    if (this->_segment_owner[cell] == 0)
+        this->_board_stats.snake_tiles++;
+    this->_segment_owner[cell] = static_cast<uint8_t>(player + 1);
+    this->_segment_sequence[cell] = this->encode_segment_sequence(player, index);
+    this->mark_cell_dirty(cell);
+    return;
+}
+
+void game_data::clear_entity(size_t cell) {
+    if (this->_segment_owner[cell] != 0)
+        this->_board_stats.snake_tiles--;
+    if (this->is_cell_occupied(cell))
+        this->mark_cell_dirty(cell);
+    this->_items[cell] = 0;
+    this->_segment_owner[cell] = 0;
+    this->_segment_sequence[cell] = 0;
+    return;
+}
+
+void game_data::set_terrain(size_t cell, int value) {
+    int previous = this->_terrain[cell];
+    if (previous == value)
+        return;
+    if (previous == GAME_TILE_WALL || value == GAME_TILE_WALL)
+        this->_neighbor_table_dirty = true;
+    if (previous == GAME_TILE_WALL) {
+        this->_board_stats.wall_tiles--;
+        this->_board_stats.open_tiles++;
+    } else if (previous == GAME_TILE_ICE)
+        this->_board_stats.ice_tiles--;
+    else if (previous == GAME_TILE_FIRE)
+        this->_board_stats.fire_tiles--;
+    if (value == GAME_TILE_WALL) {
+        this->_board_stats.wall_tiles++;
+        this->_board_stats.open_tiles--;
+    } else if (value == GAME_TILE_ICE)
+        this->_board_stats.ice_tiles++;
+    else if (value == GAME_TILE_FIRE)
+        this->_board_stats.fire_tiles++;
+    this->_terrain[cell] = static_cast<uint8_t>(value);
+    this->mark_cell_dirty(cell);
+    return;
+}
+
+// Matches a board where every tile is GAME_TILE_EMPTY and unoccupied.
+void game_data::reset_board_stats() {
+    this->_board_stats.wall_tiles = 0;
+    this->_board_stats.open_tiles = this->_width * this->_height;
+    this->_board_stats.ice_tiles = 0;
+    this->_board_stats.fire_tiles = 0;
+    this->_board_stats.snake_tiles = 0;
+    return;
+}
+
+const t_board_stats &game_data::get_board_stats() const {
+    return (this->_board_stats);
+}
+
+void game_data::build_render_snapshot(RenderSnapshot &snapshot) const {
+    static const uint8_t terrain_tiles[4] = {
+        static_cast<uint8_t>(RenderTile::TILE_EMPTY), static_cast<uint8_t>(RenderTile::TILE_WALL),
+        static_cast<uint8_t>(RenderTile::TILE_ICE), static_cast<uint8_t>(RenderTile::TILE_FIRE)};
+    static const uint8_t item_tiles[4] = {
+        static_cast<uint8_t>(RenderTile::TILE_EMPTY), static_cast<uint8_t>(RenderTile::TILE_FOOD),
+        static_cast<uint8_t>(RenderTile::TILE_FIRE_FOOD), static_cast<uint8_t>(RenderTile::TILE_FROSTY_FOOD)};
+    uint16_t head_sequence[4];
+    int player = 0;
+    while (player < 4) {
+        head_sequence[player] = this->encode_segment_sequence(player, 1);
+        snapshot.snakeLength[player] = this->_snake_length[player];
+        if (this->_snake_length[player] > 0 && !this->_snake_segments[player].empty()) {
+            snapshot.heads[player].x = this->_snake_segments[player].front().x;
+            snapshot.heads[player].y = this->_snake_segments[player].front().y;
+        } else {
+            snapshot.heads[player].x = -1;
+            snapshot.heads[player].y = -1;
+        }
+        player++;
+    }
+    size_t cells = this->_width * this->_height;
+    snapshot.generation = this->_board_generation;
+    snapshot.width = static_cast<int>(this->_width);
+    snapshot.height = static_cast<int>(this->_height);
+    snapshot.tiles.resize(cells);
+    uint8_t *tiles = snapshot.tiles.data();
+    size_t cell = 0;
+    while (cell < cells) {
+        uint8_t owner = this->_segment_owner[cell];
+        if (owner != 0)
+            tiles[cell] = static_cast<uint8_t>(
+                this->_segment_sequence[cell] == head_sequence[owner - 1] ?
+                RenderTile::TILE_SNAKE_HEAD : RenderTile::TILE_SNAKE_BODY);
+        else if (this->_items[cell] != 0 && this->_items[cell] < 4)
+            tiles[cell] = item_tiles[this->_items[cell]];
+        else if (this->_terrain[cell] < 4)
+            tiles[cell] = terrain_tiles[this->_terrain[cell]];
+        else
+            tiles[cell] = static_cast<uint8_t>(RenderTile::TILE_EMPTY);
+        cell++;
+    }
+    snapshot.baseGeneration = this->_acknowledged_generation;
+    snapshot.fullRedraw = this->_dirty_full;
+    snapshot.dirtyCells = this->_dirty_cells;
+    snapshot.applesEaten = this->get_apples_eaten();
+    snapshot.source = this;
+    this->fill_move_phase(snapshot, 0.0);
+    return;
+}
+
+void game_data::fill_move_phase(RenderSnapshot &snapshot, double pending) const {
+    int player = 0;
+    while (player < 4) {
+        double phase = 0.0;
+        if (this->_snake_length[player] > 0 && this->_direction_moving[player] != DIRECTION_NONE)
+            phase = (this->_update_timer[player] + pending) / this->move_interval(player);
+        snapshot.movePhase[player] = static_cast<float>(std::min(1.0, std::max(0.0, phase)));
+        player++;
+    }
+    return;
+}
+
+const std::vector<uint32_t> &game_data::get_dirty_cells() const {
+    return (this->_dirty_cells);
+}
+
+bool game_data::is_full_redraw_needed() const {
+    return (this->_dirty_full);
+}
+
+uint64_t game_data::get_board_generation() const {
+    return (this->_board_generation);
+}
+
+void game_data::acknowledge_dirty_cells() {
+    for (uint32_t cell : this->_dirty_cells)
+        this->_dirty_flags[cell] = 0;
+    this->_dirty_cells.clear();
+    this->_dirty_full = false;
+    this->_acknowledged_generation = this->_board_generation;
+    return;
+}
+
+void game_data::request_full_redraw() {
+    for (uint32_t cell : this->_dirty_cells)
+        this->_dirty_flags[cell] = 0;
+    this->_dirty_cells.clear();
+    this->_dirty_full = true;
+    ++this->_board_generation;
+    return;
+}
+
+uint16_t game_data::encode_segment_sequence(int player, int index) const {
+    int sequence = (this->_snake_head_sequence[player] - (index - 1)) % SNAKE_SEGMENT_RING;
+    if (sequence < 0)
+        sequence += SNAKE_SEGMENT_RING;
+    return (static_cast<uint16_t>(sequence));
+}
+
+int game_data::decode_segment_value(int player, uint16_t sequence) const {
+    int index = (this->_snake_head_sequence[player] - static_cast<int>(sequence)) %
+                SNAKE_SEGMENT_RING;
+    if (index < 0)
+        index += SNAKE_SEGMENT_RING;
+    return ((player + 1) * 1000000 + index + 1);
 }
 
 void game_data::set_player_snake_length(int player, int length) {
@@ -49,29 +251,35 @@ void game_data::apply_snake_segments(int player, const std::vector<t_coordinates
 
     this->write_snake_to_map(player);
 
-    for (const t_coordinates &coord : this->_snake_segments[player])
-        this->remove_empty_cell(coord.x, coord.y);
+    const snake_body &body = this->_snake_segments[player];
+    for (size_t i = 0; i < body.size(); ++i)
+        this->remove_empty_cell(body[i].x, body[i].y);
 }
 
 void game_data::rebuild_snake_segments_from_map(int player) {
     if (player < 0 || player >= 4)
         return;
 
-    std::deque<t_coordinates> rebuilt;
+    snake_body &rebuilt = this->_snake_segments[player];
     int offset = (player + 1) * 1000000;
     int max_value = offset + MAX_SNAKE_LENGTH;
 
-    size_t width = this->_map.get_width();
-    size_t height = this->_map.get_height();
+    size_t width = this->_width;
+    size_t height = this->_height;
+    uint8_t owner = static_cast<uint8_t>(player + 1);
 
     std::vector<std::pair<int, t_coordinates>> found;
     found.reserve(static_cast<size_t>(this->_snake_length[player]));
 
     for (size_t y = 0; y < height; ++y)
     {
+        const uint8_t *owners = this->_segment_owner.data() + y * width;
+        const uint16_t *sequences = this->_segment_sequence.data() + y * width;
         for (size_t x = 0; x < width; ++x)
         {
-            int value = this->_map.get(x, y, 2);
+            if (owners[x] != owner)
+                continue;
+            int value = this->decode_segment_value(player, sequences[x]);
             if (value >= offset + 1 && value <= max_value)
             {
                 found.emplace_back(value, t_coordinates{static_cast<int>(x), static_cast<int>(y)});
@@ -84,6 +292,7 @@ void game_data::rebuild_snake_segments_from_map(int player) {
         return lhs.first < rhs.first;
     });
 
+    rebuilt.clear();
     for (const auto &entry : found)
     {
         rebuilt.push_back(entry.second);
@@ -91,7 +300,6 @@ void game_data::rebuild_snake_segments_from_map(int player) {
             break;
     }
 
-    this->_snake_segments[player].swap(rebuilt);
     this->_snake_length[player] = static_cast<int>(this->_snake_segments[player].size());
     this->write_snake_to_map(player);
 }
@@ -101,16 +309,23 @@ void game_data::sync_snake_segments_from_map() {
         this->rebuild_snake_segments_from_map(player);
 }
 
+// Rebuilds the free-cell list in board scan order. Food placement indexes
+// into this list, so two boards holding the same tiles place food
+// identically once both have been rebuilt.
+void game_data::rebuild_empty_cells() {
+    this->initialize_empty_cells();
+}
+
 void game_data::write_snake_to_map(int player) {
     if (player < 0 || player >= 4)
         return;
 
-    int offset = (player + 1) * 1000000;
-    int index = 1;
-    for (const t_coordinates &coord : this->_snake_segments[player])
+    const snake_body &body = this->_snake_segments[player];
+    for (size_t i = 0; i < body.size(); ++i)
     {
-        this->_map.set(coord.x, coord.y, 2, offset + index);
-        ++index;
+        const t_coordinates &coord = body[i];
+        if (this->is_in_bounds(coord.x, coord.y))
+            this->set_segment(this->cell_index(coord.x, coord.y), player, static_cast<int>(i) + 1);
     }
 }
 
@@ -118,6 +333,7 @@ void game_data::reset_player_status_effects(int player) {
     if (player < 0 || player >= 4)
         return;
     this->_direction_moving[player] = DIRECTION_NONE;
+    this->_turn_count[player] = 0;
     this->_direction_moving_ice[player] = 0;
     this->_speed_boost_steps[player] = 0;
     this->_fire_boost_active[player] = false;
@@ -126,15 +342,15 @@ void game_data::reset_player_status_effects(int player) {
 }
 
 void game_data::add_empty_cell(int x, int y) {
-    size_t width = this->_map.get_width();
+    size_t width = this->_width;
     int flat = y * static_cast<int>(width) + x;
     if (flat < 0 || flat >= static_cast<int>(this->_empty_cell_indices.size()))
         return;
     if (this->_empty_cell_indices[flat] != -1)
         return;
-    if (this->_map.get(x, y, 2) != 0)
+    if (this->is_cell_occupied(static_cast<size_t>(flat)))
         return;
-    if (this->_map.get(x, y, 0) != GAME_TILE_EMPTY)
+    if (this->_terrain[flat] != GAME_TILE_EMPTY)
         return;
     this->_empty_cells.push_back((t_coordinates){x, y});
     this->_empty_cell_indices[flat] = static_cast<int>(this->_empty_cells.size() - 1);
@@ -142,7 +358,7 @@ void game_data::add_empty_cell(int x, int y) {
 }
 
 void game_data::remove_empty_cell(int x, int y) {
-    size_t width = this->_map.get_width();
+    size_t width = this->_width;
     int flat = y * static_cast<int>(width) + x;
     if (flat < 0 || flat >= static_cast<int>(this->_empty_cell_indices.size()))
         return;
@@ -162,19 +378,19 @@ void game_data::remove_empty_cell(int x, int y) {
 }
 
 void game_data::initialize_empty_cells() {
-    size_t width = this->_map.get_width();
-    size_t height = this->_map.get_height();
+    size_t width = this->_width;
+    size_t height = this->_height;
     this->_empty_cells.clear();
     this->_empty_cell_indices.assign(width * height, -1);
     size_t y = 0;
     while (y < height) {
         size_t x = 0;
         while (x < width) {
-            if (this->_map.get(x, y, 2) == 0 &&
-                this->_map.get(x, y, 0) == GAME_TILE_EMPTY) {
+            size_t flat = y * width + x;
+            if (this->_terrain[flat] == GAME_TILE_EMPTY && !this->is_cell_occupied(flat)) {
                 this->_empty_cells.push_back((t_coordinates){static_cast<int>(x),
                                                              static_cast<int>(y)});
-                this->_empty_cell_indices[y * width + x] =
+                this->_empty_cell_indices[flat] =
                     static_cast<int>(this->_empty_cells.size() - 1);
             }
             ++x;
@@ -185,46 +401,95 @@ void game_data::initialize_empty_cells() {
 }
 
 size_t game_data::get_width() const {
-    return (this->_map.get_width());
+    return (this->_width);
 }
 
 size_t game_data::get_height() const {
-    return (this->_map.get_height());
+    return (this->_height);
 }
 
-void game_data::reset_board() {
-    size_t y = 0;
-    while (y < this->_map.get_height()) {
-        size_t x = 0;
-        while (x < this->_map.get_width()) {
-            this->_map.set(x, y, 0, GAME_TILE_EMPTY);
-            this->_map.set(x, y, 1, 0);
-            this->_map.set(x, y, 2, 0);
-            ++x;
-        }
-        ++y;
+int game_data::allocate_board(int width, int height) {
+    this->_neighbor_table_dirty = true;
+    this->_dirty_full = true;
+    ++this->_board_generation;
+    if (width < 0 || height < 0)
+        return (FT_EINVAL);
+    size_t cells = static_cast<size_t>(width) * static_cast<size_t>(height);
+    try {
+        this->_terrain.assign(cells, GAME_TILE_EMPTY);
+        this->_items.assign(cells, 0);
+        this->_segment_owner.assign(cells, 0);
+        this->_segment_sequence.assign(cells, 0);
+        this->_dirty_flags.assign(cells, 0);
+        this->_dirty_cells.clear();
+        this->_dirty_cells.reserve(std::min(cells, DIRTY_CELL_LIMIT));
+        for (int player = 0; player < 4; ++player)
+            this->_snake_segments[player].reserve(std::min(cells, SNAKE_BODY_RESERVE));
+    } catch (const std::bad_alloc &) {
+        this->_terrain.clear();
+        this->_items.clear();
+        this->_segment_owner.clear();
+        this->_segment_sequence.clear();
+        this->_dirty_flags.clear();
+        this->_dirty_cells.clear();
+        this->_width = 0;
+        this->_height = 0;
+        this->reset_board_stats();
+        return (FT_EALLOC);
     }
+    this->_width = static_cast<size_t>(width);
+    this->_height = static_cast<size_t>(height);
+    this->reset_board_stats();
+    return (ER_SUCCESS);
+}
+
+void game_data::reset_board() {
+    this->reset_board(1);
+    return ;
+}
+
+void game_data::reset_board(int players) {
+    if (players < 1)
+        players = 1;
+    if (players > 4)
+        players = 4;
+    std::fill(this->_terrain.begin(), this->_terrain.end(), GAME_TILE_EMPTY);
+    std::fill(this->_items.begin(), this->_items.end(), 0);
+    std::fill(this->_segment_owner.begin(), this->_segment_owner.end(), 0);
+    std::fill(this->_segment_sequence.begin(), this->_segment_sequence.end(), 0);
+    this->reset_board_stats();
+    this->_neighbor_table_dirty = true;
+    this->request_full_redraw();
     int i = 0;
     while (i < 4) {
         this->reset_player_status_effects(i);
         this->_snake_segments[i].clear();
         this->_snake_length[i] = 0;
+        this->_snake_head_sequence[i] = 0;
         ++i;
     }
     this->_amount_players_dead = 0;
     this->initialize_empty_cells();
-    int mid_x = static_cast<int>(this->_map.get_width() / 2);
-    int mid_y = static_cast<int>(this->_map.get_height() / 2);
+    int width = static_cast<int>(this->_width);
+    int height = static_cast<int>(this->_height);
+    int mid_x = width / 2;
+    int mid_y = height / 2;
 
-    // Initialize snake with 4 segments in the middle
+    // Initialize each snake with 4 segments, player 1 in the middle row
     std::vector<t_coordinates> initial_segments;
-    initial_segments.push_back((t_coordinates){mid_x, mid_y});
-    for (int j = 1; j < 4; j++) {
-        int body_x = mid_x - j;
-        if (body_x >= 0)
-            initial_segments.push_back((t_coordinates){body_x, mid_y});
+    int player = 0;
+    while (player < players && player < height) {
+        int row = (mid_y + player * height / players) % height;
+        initial_segments.clear();
+        initial_segments.push_back((t_coordinates){mid_x, row});
+        for (int j = 1; j < 4; j++) {
+            int body_x = mid_x - j;
+            if (body_x >= 0)
+                initial_segments.push_back((t_coordinates){body_x, row});
+        }
+        this->apply_snake_segments(player, initial_segments);
+        ++player;
     }
-    this->apply_snake_segments(0, initial_segments);
 
     this->spawn_food();
     if (this->_additional_food_items)
@@ -233,9 +498,9 @@ void game_data::reset_board() {
 }
 
 void game_data::resize_board(int width, int height) {
-    this->_map.resize(width, height, 3);
-    if (this->_map.get_error()) {
-        this->_error = this->_map.get_error();
+    int error = this->allocate_board(width, height);
+    if (error != ER_SUCCESS) {
+        this->_error = error;
         return;
     }
     this->reset_board();
@@ -243,8 +508,8 @@ void game_data::resize_board(int width, int height) {
 }
 
 bool game_data::is_tile_free(int &x, int &y) const {
-    size_t width = this->_map.get_width();
-    size_t height = this->_map.get_height();
+    size_t width = this->_width;
+    size_t height = this->_height;
     if (x < 0) {
         if (this->_wrap_around_edges)
             x = static_cast<int>(width) - 1;
@@ -267,25 +532,17 @@ bool game_data::is_tile_free(int &x, int &y) const {
         else
             return false;
     }
-    if (this->_map.get(x, y, 0) == GAME_TILE_WALL)
+    size_t cell = this->cell_index(x, y);
+    if (this->_terrain[cell] == GAME_TILE_WALL)
         return false;
-    if (this->_map.get(x, y, 2) != 0)
+    if (this->is_cell_occupied(cell))
         return false;
     return true;
 }
 
 bool game_data::can_spawn_frosty_food(int x, int y) {
-    size_t width = this->_map.get_width();
-    size_t height = this->_map.get_height();
-    size_t wall_count = 0;
-    for (size_t j = 0; j < height; ++j)
-        for (size_t i = 0; i < width; ++i)
-            if (this->_map.get(static_cast<int>(i), static_cast<int>(j), 0) == GAME_TILE_WALL)
-                wall_count++;
-    size_t open_tiles = width * height - wall_count;
-    int snake_tiles = 0;
-    for (int i = 0; i < 4; ++i)
-        snake_tiles += this->_snake_length[i];
+    size_t open_tiles = this->_board_stats.open_tiles;
+    int snake_tiles = static_cast<int>(this->_board_stats.snake_tiles);
     if (snake_tiles >= static_cast<int>(open_tiles * 0.6))
         return false;
     const int dirs[4][2] = {{0,-1}, {1,0}, {0,1}, {-1,0}};
@@ -300,7 +557,7 @@ bool game_data::can_spawn_frosty_food(int x, int y) {
             continue;
         int steps = 1;
         bool valid = true;
-        while (steps < 2 || this->_map.get(tx, ty, 0) == GAME_TILE_ICE) {
+        while (steps < 2 || this->_terrain[this->cell_index(tx, ty)] == GAME_TILE_ICE) {
             tx += dirs[d][0];
             ty += dirs[d][1];
             if (!this->is_tile_free(tx, ty)) {
@@ -322,10 +579,11 @@ bool game_data::can_spawn_frosty_food(int x, int y) {
 void game_data::spawn_food() {
     while (!this->_empty_cells.empty())
     {
-        int idx = ft_dice_roll(1, static_cast<int>(this->_empty_cells.size())) - 1;
+        int idx = this->_rng.dice_roll(1, static_cast<int>(this->_empty_cells.size())) - 1;
         t_coordinates coord = this->_empty_cells[idx];
-        if (this->_map.get(coord.x, coord.y, 2) != 0 ||
-            this->_map.get(coord.x, coord.y, 0) != GAME_TILE_EMPTY)
+        size_t cell = this->cell_index(coord.x, coord.y);
+        if (this->is_cell_occupied(cell) ||
+            this->_terrain[cell] != GAME_TILE_EMPTY)
         {
             this->remove_empty_cell(coord.x, coord.y);
             continue;
@@ -333,7 +591,7 @@ void game_data::spawn_food() {
         int item = FOOD;
         if (this->_additional_food_items)
         {
-            int roll = ft_dice_roll(1, 3);
+            int roll = this->_rng.dice_roll(1, 3);
             if (roll == 2)
                 item = FIRE_FOOD;
             else if (roll == 3)
@@ -341,19 +599,20 @@ void game_data::spawn_food() {
                 bool can_frost = this->can_spawn_frosty_food(coord.x, coord.y);
                 if (can_frost && this->_wrap_around_edges == 0)
                 {
-                    size_t width = this->_map.get_width();
-                    size_t height = this->_map.get_height();
+                    size_t width = this->_width;
+                    size_t height = this->_height;
                     if ((coord.x == 0 || coord.x == static_cast<int>(width) - 1) &&
                         (coord.y == 0 || coord.y == static_cast<int>(height) - 1))
                         can_frost = false;
                 }
                 if (can_frost)
                     item = FROSTY_FOOD;
-                else if (ft_dice_roll(1, 2) == 1)
+                else if (this->_rng.dice_roll(1, 2) == 1)
                     item = FIRE_FOOD;
             }
         }
-        this->_map.set(coord.x, coord.y, 2, item);
+        this->_items[cell] = static_cast<uint8_t>(item);
+        this->mark_cell_dirty(cell);
         this->remove_empty_cell(coord.x, coord.y);
         return;
     }
@@ -364,9 +623,9 @@ void game_data::spawn_fire_tile()
 {
     if (this->_empty_cells.empty())
         return ;
-    int idx = ft_dice_roll(1, static_cast<int>(this->_empty_cells.size())) - 1;
+    int idx = this->_rng.dice_roll(1, static_cast<int>(this->_empty_cells.size())) - 1;
     t_coordinates coord = this->_empty_cells[idx];
-    this->_map.set(coord.x, coord.y, 0, GAME_TILE_FIRE);
+    this->set_terrain(this->cell_index(coord.x, coord.y), GAME_TILE_FIRE);
     this->remove_empty_cell(coord.x, coord.y);
     return;
 }
@@ -4,6 +4,8 @@ int game_data::get_error() const {
 }
 
 void game_data::set_wrap_around_edges(int value) {
+    if (value != this->_wrap_around_edges)
+        this->_neighbor_table_dirty = true;
     this->_wrap_around_edges = value;
     return;
 }
@@ -33,6 +35,31 @@ int game_data::get_additional_food_items() const
     return (this->_additional_food_items);
 }
 
+void game_data::set_simultaneous_moves(int value)
+{
+    this->_simultaneous_moves = value;
+}
+
+int game_data::get_simultaneous_moves() const
+{
+    return (this->_simultaneous_moves);
+}
+
+void game_data::set_rng_seed(uint64_t seed)
+{
+    this->_rng.seed(seed);
+}
+
+uint64_t game_data::get_rng_seed() const
+{
+    return (this->_rng.get_seed());
+}
+
+ft_rng &game_data::get_rng()
+{
+    return (this->_rng);
+}
+
 
 void game_data::set_direction_moving(int player, int direction)
 {
@@ -53,8 +80,8 @@ void game_data::set_direction_moving(int player, int direction)
                 int blocked_dir = DIRECTION_NONE;
 
                 if (this->_wrap_around_edges) {
-                    int width = static_cast<int>(this->_map.get_width());
-                    int height = static_cast<int>(this->_map.get_height());
+                    int width = static_cast<int>(this->_width);
+                    int height = static_cast<int>(this->_height);
 
                     if (second.x == (head.x - 1 + width) % width && second.y == head.y)
                         blocked_dir = DIRECTION_LEFT;
@@ -85,6 +112,57 @@ void game_data::set_direction_moving(int player, int direction)
     return;
 }
 
+void game_data::queue_direction(int player, int direction)
+{
+    if (player < 0 || player >= 4 || direction < DIRECTION_UP || direction > DIRECTION_LEFT)
+        return;
+    int count = this->_turn_count[player];
+    if (this->_direction_moving[player] == DIRECTION_NONE && count == 0)
+    {
+        this->set_direction_moving(player, direction);
+        return;
+    }
+    // A full buffer keeps the newest turn in the last slot, where it
+    // follows the turn before that one
+    if (count == TURN_BUFFER_SIZE)
+        --count;
+    int last = (count > 0) ? this->_turn_buffer[player][count - 1] : this->_direction_moving[player];
+    if (direction == last)
+        return;
+    // A reversal of the previous turn would be refused when applied
+    if (this->_snake_length[player] > 1 && direction == (last + 2) % 4)
+        return;
+    this->_turn_buffer[player][count] = direction;
+    this->_turn_count[player] = count + 1;
+    return;
+}
+
+int game_data::get_queued_turns(int player) const {
+    if (player >= 0 && player < 4)
+        return (this->_turn_count[player]);
+    return (0);
+}
+
+void game_data::apply_queued_turn(int player)
+{
+    while (this->_turn_count[player] > 0)
+    {
+        int direction = this->_turn_buffer[player][0];
+        int index = 1;
+        while (index < this->_turn_count[player])
+        {
+            this->_turn_buffer[player][index - 1] = this->_turn_buffer[player][index];
+            index++;
+        }
+        this->_turn_count[player]--;
+        int previous = this->_direction_moving[player];
+        this->set_direction_moving(player, direction);
+        if (this->_direction_moving[player] != previous)
+            return;
+    }
+    return;
+}
+
 int game_data::get_direction_moving(int player) const {
     if (player >= 0 && player < 4)
         return (this->_direction_moving[player]);
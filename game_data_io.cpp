@@ -1,5 +1,6 @@
 #include "game_data.hpp"
 #include "libft/JSon/json.hpp"
+#include "libft/Errno/errno.hpp"
 #include <filesystem>
 #include <cstdlib>
 #include <string>
@@ -100,12 +101,15 @@ static void ensure_save_dir_exists() {
 
 game_data::game_data(int width, int height) :
         _error(0), _wrap_around_edges(0), _amount_players_dead(0),
-        _moves_per_second(1.0), _additional_food_items(0),
+        _moves_per_second(1.0), _additional_food_items(0), _simultaneous_moves(0),
         _profile_name("default"),
-        _map(width, height, 3), _character()
+        _width(0), _height(0), _dirty_full(true), _board_generation(0),
+        _acknowledged_generation(0),
+        _character(), _rng(ft_rng_entropy_seed())
 {
-        if (this->_map.get_error())
-                this->_error = this->_map.get_error();
+        int board_error = this->allocate_board(width, height);
+        if (board_error != ER_SUCCESS)
+                this->_error = board_error;
         else if (this->_character.get_error())
                 this->_error = this->_character.get_error();
         int index = 0;
@@ -113,11 +117,13 @@ game_data::game_data(int width, int height) :
         {
                 this->_direction_moving_ice[index] = 0;
                 this->_direction_moving[index] = DIRECTION_NONE;
+                this->_turn_count[index] = 0;
                 this->_speed_boost_steps[index] = 0;
                 this->_fire_boost_active[index] = false;
                 this->_frosty_steps[index] = 0;
                 // Only initialize Player 1 snake, others are inactive (length 0)
                 this->_snake_length[index] = (index == 0) ? 4 : 0;
+                this->_snake_head_sequence[index] = 0;
                 this->_update_timer[index] = 0.0;
                 index++;
         }
@@ -326,13 +332,13 @@ int game_data::load_game() {
 
     auto count_player_one_segments = [&]() -> int {
         int count = 0;
-        size_t width = this->_map.get_width();
-        size_t height = this->_map.get_height();
+        size_t width = this->_width;
+        size_t height = this->_height;
         for (size_t y = 0; y < height; ++y)
         {
             for (size_t x = 0; x < width; ++x)
             {
-                int value = this->_map.get(x, y, 2);
+                int value = this->get_map_value(static_cast<int>(x), static_cast<int>(y), 2);
                 if (value >= SNAKE_HEAD_PLAYER_1 && value < SNAKE_HEAD_PLAYER_2)
                     ++count;
             }
@@ -341,13 +347,13 @@ int game_data::load_game() {
     };
 
     auto find_segment_coordinates = [&](int segmentValue, t_coordinates &out) -> bool {
-        size_t width = this->_map.get_width();
-        size_t height = this->_map.get_height();
+        size_t width = this->_width;
+        size_t height = this->_height;
         for (size_t y = 0; y < height; ++y)
         {
             for (size_t x = 0; x < width; ++x)
             {
-                if (this->_map.get(x, y, 2) == segmentValue)
+                if (this->get_map_value(static_cast<int>(x), static_cast<int>(y), 2) == segmentValue)
                 {
                     out.x = static_cast<int>(x);
                     out.y = static_cast<int>(y);
@@ -395,17 +401,18 @@ int game_data::load_game() {
                     dx = -1;
                     dy = 0;
                 }
-                int width = static_cast<int>(this->_map.get_width());
-                int height = static_cast<int>(this->_map.get_height());
+                int width = static_cast<int>(this->_width);
+                int height = static_cast<int>(this->_height);
                 while (currentSegmentCount < desiredSnakeLength)
                 {
                     int nextX = tail.x + dx;
                     int nextY = tail.y + dy;
                     if (nextX < 0 || nextX >= width || nextY < 0 || nextY >= height)
                         break;
-                    if (this->_map.get(nextX, nextY, 0) == GAME_TILE_WALL)
+                    size_t nextCell = this->cell_index(nextX, nextY);
+                    if (this->_terrain[nextCell] == GAME_TILE_WALL)
                         break;
-                    if (this->_map.get(nextX, nextY, 2) != 0)
+                    if (this->is_cell_occupied(nextCell))
                         break;
                     ++currentSegmentCount;
                     tail.x = nextX;
@@ -10,16 +10,17 @@ t_coordinates game_data::get_head_coordinate(int head_to_find) {
     int player = this->determine_player_number(head_to_find);
     if (player >= 0 && player < 4)
     {
-        const std::deque<t_coordinates> &segments = this->_snake_segments[player];
+        const snake_body &segments = this->_snake_segments[player];
         if (!segments.empty())
             return segments.front();
     }
 
     size_t index_y = 0;
-    while (index_y < this->_map.get_height()) {
+    while (index_y < this->_height) {
         size_t index_x = 0;
-        while (index_x < this->_map.get_width()) {
-            if (this->_map.get(index_x, index_y, 2) == head_to_find)
+        while (index_x < this->_width) {
+            if (this->get_map_value(static_cast<int>(index_x),
+                                    static_cast<int>(index_y), 2) == head_to_find)
                 return ((t_coordinates){static_cast<int>(index_x),
                                         static_cast<int>(index_y)});
             index_x++;
@@ -34,12 +35,12 @@ int game_data::determine_player_number(int player_head) {
 }
 
 bool game_data::advance_wrap_target(int direction, int &target_x, int &target_y) const {
-    int width = static_cast<int>(this->_map.get_width());
-    int height = static_cast<int>(this->_map.get_height());
+    int width = static_cast<int>(this->_width);
+    int height = static_cast<int>(this->_height);
     int limit = (direction == DIRECTION_UP || direction == DIRECTION_DOWN) ? height : width;
 
     for (int step = 0; step < limit; ++step) {
-        if (this->_map.get(target_x, target_y, 0) != GAME_TILE_WALL)
+        if (this->_terrain[this->cell_index(target_x, target_y)] != GAME_TILE_WALL)
             return true;
 
         switch (direction) {
@@ -62,96 +63,150 @@ bool game_data::advance_wrap_target(int direction, int &target_x, int &target_y)
     return false;
 }
 
-int game_data::is_valid_move(int player_head) {
-    t_coordinates head = this->get_head_coordinate(player_head);
-    int player_number = this->determine_player_number(player_head);
-
-    int direction_moving = this->_direction_moving[player_number];
-    if (this->_frosty_steps[player_number] > 0 ||
-        this->_map.get(head.x, head.y, 0) == GAME_TILE_ICE)
-        direction_moving = this->_direction_moving_ice[player_number];
-
-    // If no direction is set, the move is valid but the snake won't move
-    // This is handled in update_snake_position()
-    if (direction_moving == DIRECTION_NONE)
-        return (0);
-
-    int width = static_cast<int>(this->_map.get_width());
-    int height = static_cast<int>(this->_map.get_height());
-
-    if (head.x < 0 || head.x >= width || head.y < 0 || head.y >= height)
-        return (1);
-
-    int target_x = head.x;
-    int target_y = head.y;
-
-    if (direction_moving == DIRECTION_UP) {
-        target_y = head.y - 1; // UP decreases Y coordinate
-        if (target_y < 0) {
-            if (!this->_wrap_around_edges)
-                return (1);
-            target_y = height - 1;
-            if (!this->advance_wrap_target(direction_moving, target_x, target_y))
-                return (1);
-        } else if (this->_wrap_around_edges && target_y == 0 &&
-                   this->_map.get(target_x, target_y, 0) == GAME_TILE_WALL) {
+// Resolves where a head on (x, y) lands when moving in the given direction,
+// including the wrap-through across boundary walls. Returns the flat index
+// of the target cell, or -1 when the move ends on a wall or off the board.
+int game_data::compute_neighbor_cell(int x, int y, int direction) const {
+    static const int step_x[4] = {0, 1, 0, -1};
+    static const int step_y[4] = {-1, 0, 1, 0};
+    int width = static_cast<int>(this->_width);
+    int height = static_cast<int>(this->_height);
+    int target_x = x + step_x[direction];
+    int target_y = y + step_y[direction];
+    bool outside = (target_x < 0 || target_x >= width || target_y < 0 || target_y >= height);
+
+    if (outside && !this->_wrap_around_edges)
+        return (-1);
+    bool wrap = outside;
+    if (!outside && this->_wrap_around_edges &&
+        this->_terrain[this->cell_index(target_x, target_y)] == GAME_TILE_WALL) {
+        wrap = (direction == DIRECTION_UP && target_y == 0) ||
+               (direction == DIRECTION_RIGHT && target_x == width - 1) ||
+               (direction == DIRECTION_DOWN && target_y == height - 1) ||
+               (direction == DIRECTION_LEFT && target_x == 0);
+    }
+    if (wrap) {
+        if (direction == DIRECTION_UP)
             target_y = height - 1;
-            if (!this->advance_wrap_target(direction_moving, target_x, target_y))
-                return (1);
-        }
-    } else if (direction_moving == DIRECTION_RIGHT) {
-        target_x = head.x + 1;
-        if (target_x >= width) {
-            if (!this->_wrap_around_edges)
-                return (1);
-            target_x = 0;
-            if (!this->advance_wrap_target(direction_moving, target_x, target_y))
-                return (1);
-        } else if (this->_wrap_around_edges && target_x == width - 1 &&
-                   this->_map.get(target_x, target_y, 0) == GAME_TILE_WALL) {
+        else if (direction == DIRECTION_RIGHT)
             target_x = 0;
-            if (!this->advance_wrap_target(direction_moving, target_x, target_y))
-                return (1);
-        }
-    } else if (direction_moving == DIRECTION_DOWN) {
-        target_y = head.y + 1; // DOWN increases Y coordinate
-        if (target_y >= height) {
-            if (!this->_wrap_around_edges)
-                return (1);
-            target_y = 0;
-            if (!this->advance_wrap_target(direction_moving, target_x, target_y))
-                return (1);
-        } else if (this->_wrap_around_edges && target_y == height - 1 &&
-                   this->_map.get(target_x, target_y, 0) == GAME_TILE_WALL) {
+        else if (direction == DIRECTION_DOWN)
             target_y = 0;
-            if (!this->advance_wrap_target(direction_moving, target_x, target_y))
-                return (1);
-        }
-    } else if (direction_moving == DIRECTION_LEFT) {
-        target_x = head.x - 1;
-        if (target_x < 0) {
-            if (!this->_wrap_around_edges)
-                return (1);
-            target_x = width - 1;
-            if (!this->advance_wrap_target(direction_moving, target_x, target_y))
-                return (1);
-        } else if (this->_wrap_around_edges && target_x == 0 &&
-                   this->_map.get(target_x, target_y, 0) == GAME_TILE_WALL) {
+        else
             target_x = width - 1;
-            if (!this->advance_wrap_target(direction_moving, target_x, target_y))
-                return (1);
+        if (!this->advance_wrap_target(direction, target_x, target_y))
+            return (-1);
+    }
+    size_t target = this->cell_index(target_x, target_y);
+    if (this->_terrain[target] == GAME_TILE_WALL)
+        return (-1);
+    return (static_cast<int>(target));
+}
+
+void game_data::rebuild_neighbor_table() {
+    static const int step_x[4] = {0, 1, 0, -1};
+    static const int step_y[4] = {-1, 0, 1, 0};
+    int width = static_cast<int>(this->_width);
+    int height = static_cast<int>(this->_height);
+    this->_neighbor_flags.assign(this->_width * this->_height, 0);
+    this->_wrap_targets[DIRECTION_UP].assign(this->_width, -1);
+    this->_wrap_targets[DIRECTION_DOWN].assign(this->_width, -1);
+    this->_wrap_targets[DIRECTION_RIGHT].assign(this->_height, -1);
+    this->_wrap_targets[DIRECTION_LEFT].assign(this->_height, -1);
+    size_t cell = 0;
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            uint8_t flags = 0;
+            for (int direction = 0; direction < 4; ++direction) {
+                int target = this->compute_neighbor_cell(x, y, direction);
+                int next_x = x + step_x[direction];
+                int next_y = y + step_y[direction];
+                if (target < 0)
+                    flags |= static_cast<uint8_t>(1u << direction);
+                else if (!this->is_in_bounds(next_x, next_y) ||
+                         static_cast<size_t>(target) != this->cell_index(next_x, next_y)) {
+                    flags |= static_cast<uint8_t>(16u << direction);
+                    int line = (direction == DIRECTION_UP || direction == DIRECTION_DOWN) ? x : y;
+                    this->_wrap_targets[direction][line] = target;
+                }
+            }
+            this->_neighbor_flags[cell] = flags;
+            ++cell;
         }
     }
+    this->_neighbor_table_dirty = false;
+    return ;
+}
 
-    int target_val = this->_map.get(target_x, target_y, 2);
-    int offset = (player_number + 1) * 1000000;
-    int tail_value = offset + this->_snake_length[player_number];
-    if (target_val != 0 && target_val != FOOD && target_val != FIRE_FOOD && target_val != FROSTY_FOOD && target_val != tail_value)
-        return (1);
-    if (this->_map.get(target_x, target_y, 0) == GAME_TILE_WALL)
-        return (1);
+int game_data::neighbor_cell(size_t cell, int direction) {
+    if (direction < DIRECTION_UP || direction > DIRECTION_LEFT)
+        return (-1);
+    if (this->_neighbor_table_dirty)
+        this->rebuild_neighbor_table();
+    uint8_t flags = this->_neighbor_flags[cell];
+    if (flags & (1u << direction))
+        return (-1);
+    if (flags & (16u << direction)) {
+        size_t line = (direction == DIRECTION_UP || direction == DIRECTION_DOWN) ?
+            cell % this->_width : cell / this->_width;
+        return (this->_wrap_targets[direction][line]);
+    }
+    long offsets[4] = {-static_cast<long>(this->_width), 1, static_cast<long>(this->_width), -1};
+    return (static_cast<int>(static_cast<long>(cell) + offsets[direction]));
+}
 
-    return (0);
+// Resolves the head, effective direction (ice and frosty food keep the
+// sliding direction) and target cell for one step of a player, and checks
+// the target. Nothing is modified, so several plans can be made against the
+// same board before any of them is applied.
+t_move_plan game_data::plan_move(int player) {
+    t_move_plan plan;
+    plan.player = player;
+    plan.status = 1;
+    plan.direction = DIRECTION_NONE;
+    plan.head_cell = 0;
+    plan.target_cell = 0;
+    if (player < 0 || player >= 4 || this->_snake_segments[player].empty())
+        return (plan);
+
+    // If no direction is set, the move is valid but the snake won't move
+    plan.status = 0;
+    if (this->_direction_moving[player] == DIRECTION_NONE)
+        return (plan);
+
+    t_coordinates head = this->_snake_segments[player].front();
+    if (!this->is_in_bounds(head.x, head.y)) {
+        plan.status = 1;
+        return (plan);
+    }
+    plan.head_cell = this->cell_index(head.x, head.y);
+
+    int direction_moving = this->_direction_moving[player];
+    if (this->_frosty_steps[player] > 0 ||
+        this->_terrain[plan.head_cell] == GAME_TILE_ICE)
+        direction_moving = this->_direction_moving_ice[player];
+    if (direction_moving == DIRECTION_NONE)
+        return (plan);
+
+    int target = this->neighbor_cell(plan.head_cell, direction_moving);
+    if (target < 0) {
+        plan.status = 1;
+        return (plan);
+    }
+    int target_val = this->entity_value(static_cast<size_t>(target));
+    int tail_value = (player + 1) * 1000000 + this->_snake_length[player];
+    if (target_val != 0 && target_val != FOOD && target_val != FIRE_FOOD &&
+        target_val != FROSTY_FOOD && target_val != tail_value) {
+        plan.status = 1;
+        return (plan);
+    }
+    plan.direction = direction_moving;
+    plan.target_cell = static_cast<size_t>(target);
+    return (plan);
+}
+
+int game_data::is_valid_move(int player_head) {
+    return (this->plan_move(this->determine_player_number(player_head)).status);
 }
 
 // Testing method - exposes private is_valid_move for unit tests
@@ -165,7 +220,7 @@ t_coordinates game_data::get_next_piece(t_coordinates current_coordinate, int pi
     if (player < 0 || player >= 4)
         return ((t_coordinates){-1, -1});
 
-    const std::deque<t_coordinates> &segments = this->_snake_segments[player];
+    const snake_body &segments = this->_snake_segments[player];
     if (segments.empty())
         return ((t_coordinates){-1, -1});
 
@@ -178,97 +233,28 @@ t_coordinates game_data::get_next_piece(t_coordinates current_coordinate, int pi
 }
 
 int game_data::update_snake_position(int player_head) {
-    int player_number = this->determine_player_number(player_head);
-    if (player_number < 0 || player_number >= 4)
-        return (1);
+    return (this->apply_move(this->plan_move(this->determine_player_number(player_head)), nullptr));
+}
 
-    std::deque<t_coordinates> &segments = this->_snake_segments[player_number];
-    if (segments.empty())
+// Performs a move resolved by plan_move. Returns 1 when the plan is a
+// collision (game over), 0 otherwise. With deferred set, food and fire
+// tiles the move earns are counted there instead of being placed.
+int game_data::apply_move(const t_move_plan &plan, t_spawn_requests *deferred) {
+    if (plan.status != 0)
         return (1);
-
-    t_coordinates current_coords = segments.front();
-
-    // Check if no direction is set - if so, don't move but don't game over either
-    if (this->_direction_moving[player_number] == DIRECTION_NONE)
+    if (plan.direction == DIRECTION_NONE)
         return (0);
 
-    // Check for collisions before moving
-    if (this->is_valid_move(player_head) != 0)
-        return (1);
-    int direction_moving = this->_direction_moving[player_number];
+    int player_number = plan.player;
+    snake_body &segments = this->_snake_segments[player_number];
+    int direction_moving = plan.direction;
     bool frosty_active = (this->_frosty_steps[player_number] > 0);
-    if (frosty_active ||
-        this->_map.get(current_coords.x, current_coords.y, 0) == GAME_TILE_ICE)
-        direction_moving = this->_direction_moving_ice[player_number];
-    int width = static_cast<int>(this->_map.get_width());
-    int height = static_cast<int>(this->_map.get_height());
-    int target_x = current_coords.x;
-    int target_y = current_coords.y;
-    if (direction_moving == DIRECTION_UP) {
-        target_y = current_coords.y - 1; // UP decreases Y coordinate
-        if (target_y < 0) {
-            if (!this->_wrap_around_edges)
-                return (1); // Game over - hit boundary
-            target_y = height - 1;
-            if (!this->advance_wrap_target(direction_moving, target_x, target_y))
-                return (1);
-        } else if (this->_wrap_around_edges && target_y == 0 &&
-                   this->_map.get(target_x, target_y, 0) == GAME_TILE_WALL) {
-            target_y = height - 1;
-            if (!this->advance_wrap_target(direction_moving, target_x, target_y))
-                return (1);
-        }
-    } else if (direction_moving == DIRECTION_RIGHT) {
-        target_x = current_coords.x + 1;
-        if (target_x >= width) {
-            if (!this->_wrap_around_edges)
-                return (1); // Game over - hit boundary
-            target_x = 0;
-            if (!this->advance_wrap_target(direction_moving, target_x, target_y))
-                return (1);
-        } else if (this->_wrap_around_edges && target_x == width - 1 &&
-                   this->_map.get(target_x, target_y, 0) == GAME_TILE_WALL) {
-            target_x = 0;
-            if (!this->advance_wrap_target(direction_moving, target_x, target_y))
-                return (1);
-        }
-    } else if (direction_moving == DIRECTION_DOWN) {
-        target_y = current_coords.y + 1; // DOWN increases Y coordinate
-        if (target_y >= height) {
-            if (!this->_wrap_around_edges)
-                return (1); // Game over - hit boundary
-            target_y = 0;
-            if (!this->advance_wrap_target(direction_moving, target_x, target_y))
-                return (1);
-        } else if (this->_wrap_around_edges && target_y == height - 1 &&
-                   this->_map.get(target_x, target_y, 0) == GAME_TILE_WALL) {
-            target_y = 0;
-            if (!this->advance_wrap_target(direction_moving, target_x, target_y))
-                return (1);
-        }
-    } else if (direction_moving == DIRECTION_LEFT) {
-        target_x = current_coords.x - 1;
-        if (target_x < 0) {
-            if (!this->_wrap_around_edges)
-                return (1); // Game over - hit boundary
-            target_x = width - 1;
-            if (!this->advance_wrap_target(direction_moving, target_x, target_y))
-                return (1);
-        } else if (this->_wrap_around_edges && target_x == 0 &&
-                   this->_map.get(target_x, target_y, 0) == GAME_TILE_WALL) {
-            target_x = width - 1;
-            if (!this->advance_wrap_target(direction_moving, target_x, target_y))
-                return (1);
-        }
-    }
-
-    // Final safety check - ensure target coordinates are valid
-    if (target_x < 0 || target_x >= width || target_y < 0 || target_y >= height)
-        return (1); // Game over - invalid coordinates
+    size_t target_cell = plan.target_cell;
+    int target_x = static_cast<int>(target_cell % this->_width);
+    int target_y = static_cast<int>(target_cell / this->_width);
 
-    bool on_ice_now = (this->_map.get(current_coords.x, current_coords.y, 0) ==
-                       GAME_TILE_ICE);
-    int tile_type = this->_map.get(target_x, target_y, 0);
+    bool on_ice_now = (this->_terrain[plan.head_cell] == GAME_TILE_ICE);
+    int tile_type = this->_terrain[target_cell];
     bool on_ice_next = (tile_type == GAME_TILE_ICE);
     bool on_fire_next = (tile_type == GAME_TILE_FIRE);
     if (!on_ice_now && on_ice_next)
@@ -282,26 +268,30 @@ int game_data::update_snake_position(int player_head) {
         if (this->_frosty_steps[player_number] == 0 && !on_ice_next)
             this->_direction_moving_ice[player_number] = 0;
     }
-    int tile_val = this->_map.get(target_x, target_y, 2);
+    int tile_val = this->_items[target_cell];
     bool ate_food = (tile_val == FOOD || tile_val == FIRE_FOOD || tile_val == FROSTY_FOOD);
     bool grow_snake = ate_food && this->_snake_length[player_number] < MAX_SNAKE_LENGTH;
 
     this->remove_empty_cell(target_x, target_y);
 
-    segments.push_front((t_coordinates){target_x, target_y});
-
     if (!grow_snake)
     {
         t_coordinates removed = segments.back();
         segments.pop_back();
         if (!(removed.x == target_x && removed.y == target_y))
         {
-            this->_map.set(removed.x, removed.y, 2, 0);
+            this->clear_entity(this->cell_index(removed.x, removed.y));
             this->add_empty_cell(removed.x, removed.y);
         }
     }
 
-    this->write_snake_to_map(player_number);
+    // Advancing the head sequence shifts every existing segment's index by
+    // one, so only the new head cell needs to be written.
+    this->mark_cell_dirty(plan.head_cell);
+    segments.push_front((t_coordinates){target_x, target_y});
+    this->_snake_head_sequence[player_number] =
+        (this->_snake_head_sequence[player_number] + 1) % SNAKE_SEGMENT_RING;
+    this->set_segment(target_cell, player_number, 1);
 
     int previous_length = this->_snake_length[player_number];
     int new_length = static_cast<int>(segments.size());
@@ -364,55 +354,160 @@ int game_data::update_snake_position(int player_head) {
             if (this->_snake_length[player_number] >= goal &&
                 !snake.is_goal_complete(ACH_GOAL_PRIMARY))
                 snake.set_progress(ACH_GOAL_PRIMARY, goal);
-            this->spawn_food();
+            if (deferred)
+                ++deferred->food;
+            else
+                this->spawn_food();
         }
     }
     if (on_fire_next)
     {
         this->_fire_boost_active[player_number] = true;
         this->_speed_boost_steps[player_number] = FIRE_BOOST_STEPS;
-        this->_map.set(target_x, target_y, 0, GAME_TILE_EMPTY);
+        this->set_terrain(target_cell, GAME_TILE_EMPTY);
         if (this->_additional_food_items)
-            this->spawn_fire_tile();
+        {
+            if (deferred)
+                ++deferred->fire_tiles;
+            else
+                this->spawn_fire_tile();
+        }
     }
     return (0);
 }
 
+double game_data::move_interval(int player) const
+{
+    double interval = 1.0 / this->_moves_per_second; // Moves per second is configurable
+    if (this->_fire_boost_active[player] || this->_speed_boost_steps[player] > 0)
+        interval /= 1.5;
+    return (interval);
+}
+
+void game_data::consume_speed_boost(int player)
+{
+    if (this->_speed_boost_steps[player] > 0)
+    {
+        --this->_speed_boost_steps[player];
+        if (this->_speed_boost_steps[player] <= 0)
+        {
+            this->_speed_boost_steps[player] = 0;
+            this->_fire_boost_active[player] = false;
+        }
+    }
+    return ;
+}
+
+// Marks plans that cannot all happen in the same step: two heads entering
+// the same cell, or two heads swapping places. Both sides of a conflict
+// collide, so the outcome does not depend on player order.
+void game_data::resolve_move_conflicts(t_move_plan *plans, int count) const
+{
+    bool collided[4] = {false, false, false, false};
+    int a = 0;
+    while (a < count)
+    {
+        int b = 0;
+        while (plans[a].status == 0 && plans[a].direction != DIRECTION_NONE && b < count)
+        {
+            if (b != a && plans[b].status == 0 && plans[b].direction != DIRECTION_NONE)
+            {
+                if (plans[a].target_cell == plans[b].target_cell)
+                    collided[a] = true;
+                else if (plans[a].target_cell == plans[b].head_cell &&
+                         plans[b].target_cell == plans[a].head_cell)
+                    collided[a] = true;
+            }
+            ++b;
+        }
+        ++a;
+    }
+    a = 0;
+    while (a < count)
+    {
+        if (collided[a])
+            plans[a].status = 1;
+        ++a;
+    }
+    return ;
+}
+
+// Steps every due player against the same board state before any move is
+// committed. Cells occupied at the start of the step block a move (except
+// the mover's own tail), and conflicts between movers are resolved by
+// resolve_move_conflicts. Spawns wait until all moves of the step are on
+// the board, so they never land on a cell another player is entering and
+// their random draws do not depend on which player ate first.
+int game_data::update_game_map_simultaneous(double deltaTime)
+{
+    int ret = 0;
+    int i = 0;
+    while (i < 4)
+    {
+        if (this->_snake_length[i] > 0)
+            this->_update_timer[i] += deltaTime;
+        ++i;
+    }
+    while (true)
+    {
+        t_move_plan plans[4];
+        int count = 0;
+        i = 0;
+        while (i < 4)
+        {
+            double interval = this->move_interval(i);
+            if (this->_snake_length[i] > 0 && this->_update_timer[i] >= interval)
+            {
+                this->_update_timer[i] -= interval;
+                this->apply_queued_turn(i);
+                plans[count] = this->plan_move(i);
+                ++count;
+            }
+            ++i;
+        }
+        if (count == 0)
+            break;
+        this->resolve_move_conflicts(plans, count);
+        t_spawn_requests spawns = {0, 0};
+        i = 0;
+        while (i < count)
+        {
+            if (this->apply_move(plans[i], &spawns))
+                ret = 1;
+            this->consume_speed_boost(plans[i].player);
+            ++i;
+        }
+        while (spawns.food-- > 0)
+            this->spawn_food();
+        while (spawns.fire_tiles-- > 0)
+            this->spawn_fire_tile();
+    }
+    return (ret);
+}
+
 int game_data::update_game_map(double deltaTime)
 {
+    if (this->_simultaneous_moves)
+        return (this->update_game_map_simultaneous(deltaTime));
     int ret = 0;
     int heads[4] = {
         SNAKE_HEAD_PLAYER_1,
         SNAKE_HEAD_PLAYER_2,
         SNAKE_HEAD_PLAYER_3,
         SNAKE_HEAD_PLAYER_4};
-    const double baseInterval = 1.0 / this->_moves_per_second; // Moves per second is configurable
     int i = 0;
     while (i < 4)
     {
         if (this->_snake_length[i] > 0)
         {
             this->_update_timer[i] += deltaTime;
-            double interval = baseInterval;
-            if (this->_fire_boost_active[i] || this->_speed_boost_steps[i] > 0)
-                interval /= 1.5;
-            while (this->_update_timer[i] >= interval)
+            while (this->_update_timer[i] >= this->move_interval(i))
             {
-                this->_update_timer[i] -= interval;
+                this->_update_timer[i] -= this->move_interval(i);
+                this->apply_queued_turn(i);
                 if (this->update_snake_position(heads[i]))
                     ret = 1;
-                if (this->_speed_boost_steps[i] > 0)
-                {
-                    --this->_speed_boost_steps[i];
-                    if (this->_speed_boost_steps[i] <= 0)
-                    {
-                        this->_speed_boost_steps[i] = 0;
-                        this->_fire_boost_active[i] = false;
-                    }
-                }
-                interval = baseInterval;
-                if (this->_fire_boost_active[i] || this->_speed_boost_steps[i] > 0)
-                    interval /= 1.5;
+                this->consume_speed_boost(i);
             }
         }
         ++i;
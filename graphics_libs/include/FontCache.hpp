@@ -1,7 +1,9 @@
 #pragma once
 
+#include <functional>
 #include <optional>
 #include <string>
+#include <vector>
 
 namespace graphics::font_cache {
 
@@ -11,8 +13,29 @@ const std::optional<std::string>& get();
 // Store a resolved font path for reuse across graphics libraries.
 void set(const std::string& path);
 
-// Clear the cached path (primarily for error handling scenarios).
+// Clear the cached path (primarily for error handling scenarios). The
+// on-disk index is read again on the next resolve().
 void reset();
 
-} // namespace graphics::font_cache
+// Finds a font that tryLoad accepts. Candidates come from the on-disk
+// index under save_data/, which remembers per file its mtime, size and
+// whether each loader (consumer, e.g. "sdl2") accepted it:
+//  - fonts the consumer accepted before are tried first, preferredFonts
+//    ahead of the rest, then fonts it never tried; rejected ones are
+//    skipped until the file changes
+//  - the font directories are only walked when the index has nothing
+//    usable, typically on the very first run
+// After an answer from the index, the index is revalidated once per
+// process on a background thread (stat calls and a directory walk, never
+// a font load) so new or removed fonts show up on the next run.
+std::optional<std::string> resolve(const std::string& consumer, const std::vector<std::string>& preferredFonts,
+                                   const std::function<bool(const std::string&)>& tryLoad);
+
+// Points the index and directory walk somewhere else, for tests. An empty
+// indexPath restores save_data/font_index.txt and the system directories.
+void configure(const std::string& indexPath, const std::vector<std::string>& fontDirectories);
 
+// Blocks until a running background revalidation has finished.
+void waitForRevalidation();
+
+} // namespace graphics::font_cache
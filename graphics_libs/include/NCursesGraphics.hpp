@@ -4,6 +4,7 @@
 #include "../../MenuSystem.hpp"
 #include <ncurses.h>
 #include <string>
+#include <vector>
 
 class NCursesGraphics : public IGraphicsLibrary {
   public:
@@ -12,8 +13,12 @@ class NCursesGraphics : public IGraphicsLibrary {
 
     virtual int initialize() override;
     virtual void shutdown() override;
+    virtual bool suspend() override;
+    virtual int resume() override;
     virtual void render(const game_data& game) override;
+    virtual void render(const RenderSnapshot& snapshot) override;
     virtual GameKey getInput() override;
+    virtual int waitForInput(int timeoutMs) override;
     virtual const char* getName() const override;
     virtual bool shouldContinue() const override;
     virtual void setFrameRate(int fps) override;
@@ -33,8 +38,13 @@ class NCursesGraphics : public IGraphicsLibrary {
 
     void forceInputReadiness();
 
+    // Exported through getGraphicsCapabilities()
+    static const GraphicsCapabilities CAPABILITIES;
+
   private:
     bool _initialized;
+    // Between endwin() in suspend() and the refresh in resume()
+    bool _suspended;
     bool _shouldContinue;
     int _frameRate;
     std::string _errorMessage;
@@ -48,6 +58,26 @@ class NCursesGraphics : public IGraphicsLibrary {
     // Track active palette for ncurses color pairs
     bool _altColorsActive = false;
 
+    // Filled by the game_data overload for callers without a snapshot
+    RenderSnapshot _compatSnapshot;
+
+    // Shadow of the board as last written to stdscr, one chtype (glyph and
+    // colour pair) per cell, 0 for cells not written since the last
+    // clear(). Frames only write the cells that differ from it.
+    std::vector<chtype> _shadow;
+    // One changed run of a row, written with a single mvaddchnstr()
+    std::vector<chtype> _runBuffer;
+    // Glyph and colour pair per RenderTile
+    chtype _tileGlyphs[static_cast<int>(RenderTile::TILE_SNAKE_BODY) + 1];
+    // Layout the shadow was drawn with; any change clears the screen
+    bool _layoutValid;
+    bool _showingMenu;
+    int _layoutTermWidth;
+    int _layoutTermHeight;
+    int _layoutBoardWidth;
+    int _layoutBoardHeight;
+    bool _layoutBorders;
+
        enum ColorPairs {
         COLOR_SNAKE_HEAD = 1,
         COLOR_SNAKE_BODY = 2,
@@ -62,11 +92,11 @@ class NCursesGraphics : public IGraphicsLibrary {
     };
 
     void initializeColors();
-    void drawBorder(const game_data& game);
-    void drawGameArea(const game_data& game);
-    void drawInfo(const game_data& game);
-    char getCharFromGameTile(int x, int y, const game_data& game);
-    int getColorFromGameTile(int x, int y, const game_data& game);
+    void drawInfo(const RenderSnapshot& snapshot);
+    void drawBoardFrame(int startY, int startX, int width, int height);
+    void drawBoardCells(const RenderSnapshot& snapshot, int offsetY, int offsetX, bool fullPass);
+    static char getCharFromTile(RenderTile tile);
+    static int getColorFromTile(RenderTile tile);
     void setError(const std::string& error);
     void clearError();
 
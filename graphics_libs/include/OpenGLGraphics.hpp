@@ -3,6 +3,7 @@
 #include "../../IGraphicsLibrary.hpp"
 #include "../../MenuSystem.hpp"
 #include <GLFW/glfw3.h>
+#include <deque>
 #include <string>
 #include <vector>
 #include <map>
@@ -20,15 +21,24 @@ class OpenGLGraphics : public IGraphicsLibrary {
     // IGraphicsLibrary interface implementation
     virtual int initialize() override;
     virtual void shutdown() override;
+    virtual bool suspend() override;
+    virtual int resume() override;
     virtual void render(const game_data& game) override;
+    virtual void render(const RenderSnapshot& snapshot) override;
     virtual GameKey getInput() override;
+    virtual int pollInputEvents(InputEvent* events, int maxEvents) override;
+    virtual int waitForInput(int timeoutMs) override;
     bool shouldContinue() const override;
     const char* getError() const override;
     const char* getName() const override;
     void setFrameRate(int fps) override;
+    virtual void setVsync(bool enabled) override;
     virtual void setMenuSystem(MenuSystem* menuSystem) override;
     virtual void setSwitchMessage(const std::string& message, int duration) override;
 
+    // Exported through getGraphicsCapabilities()
+    static const GraphicsCapabilities CAPABILITIES;
+
   private:
     // Window and rendering
     GLFWwindow* _window;
@@ -38,6 +48,8 @@ class OpenGLGraphics : public IGraphicsLibrary {
 
     // Menu system
     MenuSystem* _menuSystem;
+    // Filled by the game_data overload for callers without a snapshot
+    RenderSnapshot _compatSnapshot;
 
     // Error handling
     std::string _errorMessage;
@@ -46,13 +58,15 @@ class OpenGLGraphics : public IGraphicsLibrary {
     std::string _switchMessage;
     int _switchMessageTimer;
 
-    // Input handling
-    GameKey _lastKeyPressed;
-    bool _keyConsumed;
+    // Input handling: keys from the GLFW callback, oldest first
+    static const size_t MAX_PENDING_KEYS = 32;
+    std::deque<InputEvent> _pendingKeys;
+    void queueKey(GameKey key);
 
   // --- Font / text rendering ---
   struct Glyph {
-    unsigned int textureId; // OpenGL texture for the glyph bitmap
+    // Rectangle of the glyph bitmap in the atlas, in texture coordinates
+    float u0, v0, u1, v1;
     int width;
     int height;
     int bearingX; // Left bearing
@@ -61,11 +75,51 @@ class OpenGLGraphics : public IGraphicsLibrary {
     unsigned int index; // FreeType glyph index (for kerning)
   };
 
+  // Glyph bitmaps shelf-packed into one alpha image, with their metrics;
+  // rasterised by FreeType or read back from the disk cache
+  struct PackedGlyph {
+    char c;
+    int x; // Top-left of the bitmap in the atlas, in pixels
+    int y;
+    Glyph metrics;
+  };
+  struct GlyphAtlasImage {
+    int width = 0;
+    int height = 0;
+    std::vector<unsigned char> pixels;
+    std::vector<PackedGlyph> glyphs;
+  };
+
   bool _fontInitialized;
   int _fontPixelSize = 24;
   FT_Library _ftLibrary = nullptr;
   FT_Face _ftFace = nullptr;
   std::map<char, Glyph> _glyphs; // Basic ASCII glyph cache
+  // Every glyph bitmap packed into one alpha texture, so a whole frame of
+  // text is a single textured draw
+  unsigned int _glyphAtlas = 0;
+
+  // --- Batched drawing ---
+  // Plain and textured quads queued since the last flush, each kind drawn
+  // with one glDrawArrays from client-side arrays. Queuing one kind
+  // flushes the other first so overlapping draws keep their order.
+  std::vector<float> _quadVertices; // x, y per vertex
+  std::vector<float> _quadColors;   // r, g, b, a per vertex
+  std::vector<float> _textVertices; // x, y, u, v per vertex
+  std::vector<float> _textColors;   // r, g, b, a per vertex
+
+  // Board geometry kept between frames, one quad per cell (empty cells
+  // are degenerate), patched from the snapshot's dirty cells
+  std::vector<float> _boardVertices;
+  std::vector<float> _boardColors;
+  float _tilePalette[static_cast<int>(RenderTile::TILE_SNAKE_BODY) + 1][4];
+  bool _boardValid = false;
+  bool _boardAltPalette = false;
+  int _boardWidth = 0;
+  int _boardHeight = 0;
+  int _boardCellSize = 0;
+  int _boardOffsetX = 0;
+  int _boardOffsetY = 0;
 
     // Window dimensions
     static const int WINDOW_WIDTH = 1280;
@@ -106,8 +160,14 @@ class OpenGLGraphics : public IGraphicsLibrary {
     void clearError();
     void setError(const std::string& error);
     GameKey translateGLFWKey(int key);
-    void calculateGameArea(const game_data& game, int& offsetX, int& offsetY, int& cellSize);
+    void calculateGameArea(const RenderSnapshot& snapshot, int& offsetX, int& offsetY, int& cellSize);
     void drawRectangle(int x, int y, int width, int height, const Color& color);
+    void flushQuads();
+    void flushText();
+    void flushBatches();
+    void updateBoardGeometry(const RenderSnapshot& snapshot, int offsetX, int offsetY, int cellSize, bool useAlt);
+    void writeBoardCell(size_t cell, uint8_t tile);
+    void drawBoard();
     void drawText(const std::string& text, int x, int y, const Color& color, float scale = 1.0f);
     int  measureTextWidth(const std::string& text, float scale = 1.0f) const;
     void drawCenteredText(const std::string& text, int y, const Color& color, float scale = 1.0f);
@@ -118,7 +178,11 @@ class OpenGLGraphics : public IGraphicsLibrary {
   bool initializeFonts();
   void shutdownFonts();
   bool loadFontFace(const std::string& path);
-  bool buildGlyphCache();
+  bool buildGlyphCache(const std::string& fontPath);
+  bool rasterizeGlyphAtlas(GlyphAtlasImage& atlas);
+  void uploadGlyphAtlas(const GlyphAtlasImage& atlas);
+  static bool loadGlyphAtlasFile(const std::string& cachePath, const std::string& key, GlyphAtlasImage& atlas);
+  static void saveGlyphAtlasFile(const std::string& cachePath, const std::string& key, const GlyphAtlasImage& atlas);
   void renderText(const std::string& text, float x, float y, float scale, const Color& color);
 
     void renderMainMenu();
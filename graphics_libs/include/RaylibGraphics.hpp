@@ -2,11 +2,14 @@
 
 #include "../../IGraphicsLibrary.hpp"
 #include "../../MenuSystem.hpp"
+#include <cstdint>
 #include <string>
 #include <vector>
 
 // Forward declare to avoid including raylib everywhere in headers
 struct Font; // not used directly; raylib manages default font internally
+struct Color;
+struct RenderTexture;
 
 class RaylibGraphics : public IGraphicsLibrary {
   public:
@@ -15,7 +18,10 @@ class RaylibGraphics : public IGraphicsLibrary {
 
     int initialize() override;
     void shutdown() override;
+    bool suspend() override;
+    int resume() override;
     void render(const game_data& game) override;
+    void render(const RenderSnapshot& snapshot) override;
     GameKey getInput() override;
     const char* getName() const override;
     bool shouldContinue() const override;
@@ -24,6 +30,9 @@ class RaylibGraphics : public IGraphicsLibrary {
     void setMenuSystem(MenuSystem* menuSystem) override;
     void setSwitchMessage(const std::string& message, int timer) override;
 
+    // Exported through getGraphicsCapabilities()
+    static const GraphicsCapabilities CAPABILITIES;
+
   private:
     struct Color {
         unsigned char r, g, b, a;
@@ -61,16 +70,44 @@ class RaylibGraphics : public IGraphicsLibrary {
     int _targetFPS;
 
     MenuSystem* _menuSystem;
+    // Filled by the game_data overload for callers without a snapshot
+    RenderSnapshot _compatSnapshot;
     std::string _switchMessage;
     int _switchMessageTimer;
 
     std::string _errorMessage;
 
+    // Walls, ice and fire pre-rendered at board size, redrawn only when a
+    // terrain cell, the layout or the palette changes. Null until the first
+    // game frame, and when render textures are unavailable.
+    RenderTexture* _terrainTarget;
+    bool _terrainDirty;
+    bool _terrainAltPalette;
+    int _terrainCellSize;
+
+    // Board mirror patched from the snapshot's dirty cells, so a frame
+    // costs the snake and food, not the board area
+    bool _boardValid;
+    int _boardWidth;
+    int _boardHeight;
+    std::vector<uint8_t> _boardTiles;
+    // Last terrain seen per cell; cells under the snake or food keep it
+    std::vector<uint8_t> _terrainTiles;
+    // Cells holding the snake or food, drawn over the terrain every frame.
+    // _dynamicSlot maps a cell to its index in _dynamicCells, or -1.
+    std::vector<uint32_t> _dynamicCells;
+    std::vector<int32_t> _dynamicSlot;
+
+    void updateBoard(const RenderSnapshot& snapshot);
+    void setBoardCell(uint32_t cell, uint8_t tile);
+    void rebuildTerrain(int cellSize, bool useAlt, const ::Color* palette);
+    void unloadTerrain();
+
     // Helpers
     void setError(const std::string& msg);
     void clearError();
 
-    void calculateGameArea(const game_data& game, int& offsetX, int& offsetY, int& cellSize);
+    void calculateGameArea(const RenderSnapshot& snapshot, int& offsetX, int& offsetY, int& cellSize);
     void drawRect(int x, int y, int w, int h, const Color& color, bool filled = true);
     void drawText(const std::string& text, int x, int y, const Color& color, int size);
     void drawCenteredText(const std::string& text, int y, const Color& color, int size);
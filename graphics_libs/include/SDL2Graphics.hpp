@@ -4,7 +4,9 @@
 #include "../../MenuSystem.hpp"
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_ttf.h>
+#include <list>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 class SDL2Graphics : public IGraphicsLibrary {
@@ -15,15 +17,23 @@ class SDL2Graphics : public IGraphicsLibrary {
     // IGraphicsLibrary interface implementation
     virtual int initialize() override;
     virtual void shutdown() override;
+    virtual bool suspend() override;
+    virtual int resume() override;
     virtual void render(const game_data& game) override;
+    virtual void render(const RenderSnapshot& snapshot) override;
     virtual GameKey getInput() override;
+    virtual int waitForInput(int timeoutMs) override;
     virtual const char* getName() const override;
     virtual bool shouldContinue() const override;
     virtual const char* getError() const override;
     virtual void setFrameRate(int fps) override;
+    virtual void setVsync(bool enabled) override;
     virtual void setMenuSystem(MenuSystem* menuSystem) override;
     virtual void setSwitchMessage(const std::string& message, int timer) override;
 
+    // Exported through getGraphicsCapabilities()
+    static const GraphicsCapabilities CAPABILITIES;
+
   private:
     bool _initialized;
     bool _shouldContinue;
@@ -35,13 +45,74 @@ class SDL2Graphics : public IGraphicsLibrary {
     SDL_Window* _window;
     SDL_Renderer* _renderer;
 
+    // Walls, ice and fire pre-rendered at board size. Rebuilt only when a
+    // terrain cell, the layout or the palette changes, or the renderer
+    // drops its targets; null when render targets are unavailable.
+    SDL_Texture* _terrainTexture;
+    bool _terrainDirty;
+    bool _terrainAltPalette;
+    int _terrainCellSize;
+    int _terrainWidth;
+    int _terrainHeight;
+    // Last terrain seen per cell. Cells hidden under the snake or food
+    // keep what was there before.
+    std::vector<Uint8> _terrainTiles;
+
+    // Dynamic cells collected per frame, one SDL_RenderFillRects per colour
+    enum BoardBatch {
+        BATCH_FOOD_BACKING,
+        BATCH_FOOD,
+        BATCH_FIRE_FOOD,
+        BATCH_FROSTY_FOOD,
+        BATCH_SNAKE_HEAD,
+        BATCH_SNAKE_BODY,
+        BATCH_COUNT
+    };
+    std::vector<SDL_Rect> _boardBatches[BATCH_COUNT];
+
     // Font objects
     TTF_Font* _fontLarge;  // For titles
     TTF_Font* _fontMedium; // For menu items
     TTF_Font* _fontSmall;  // For instructions
 
+    // Rendered strings, least recently used dropped first, so menu pages,
+    // labels and the switch banner cost a texture copy per frame instead
+    // of a TTF rasterisation
+    struct TextKey {
+        TTF_Font* font;
+        Uint32 color;
+        std::string text;
+        bool operator==(const TextKey& other) const {
+            return font == other.font && color == other.color && text == other.text;
+        }
+    };
+    struct TextKeyHash {
+        size_t operator()(const TextKey& key) const;
+    };
+    struct TextTexture {
+        TextKey key;
+        SDL_Texture* texture;
+        int width;
+        int height;
+    };
+    static const size_t TEXT_CACHE_CAPACITY = 256;
+    std::list<TextTexture> _textCache; // Most recently used first
+    std::unordered_map<TextKey, std::list<TextTexture>::iterator, TextKeyHash> _textCacheIndex;
+
+    // Digits rendered once per font in white and tinted on copy, for
+    // numbers that change too often to cache as whole strings
+    struct DigitAtlas {
+        TTF_Font* font;
+        SDL_Texture* texture;
+        int offsets[11]; // Left edge of each digit; offsets[10] is the total width
+        int height;
+    };
+    std::vector<DigitAtlas> _digitAtlases;
+
     // Menu system
     MenuSystem* _menuSystem;
+    // Filled by the game_data overload for callers without a snapshot
+    RenderSnapshot _compatSnapshot;
 
     // Switch message display
     std::string _switchMessage;
@@ -90,7 +161,14 @@ class SDL2Graphics : public IGraphicsLibrary {
     void drawTransparentRect(int x, int y, int width, int height, const Color& color, Uint8 alpha);
     void drawText(const std::string& text, int x, int y);
     GameKey translateSDLKey(SDL_Keycode key);
-    void calculateGameArea(const game_data& game, int& offsetX, int& offsetY, int& cellSize);
+    void calculateGameArea(const RenderSnapshot& snapshot, int& offsetX, int& offsetY, int& cellSize);
+
+    // Board drawing
+    void drawBoard(const RenderSnapshot& snapshot, int offsetX, int offsetY, int cellSize, bool useAlt);
+    bool updateTerrain(const RenderSnapshot& snapshot);
+    void drawTerrain(int cellSize, bool useAlt);
+    void rebuildTerrainTexture(int cellSize, bool useAlt);
+    void destroyTerrainTexture();
 
     // Font methods
     bool initializeFonts();
@@ -99,6 +177,10 @@ class SDL2Graphics : public IGraphicsLibrary {
     void drawCenteredTextWithFont(const std::string& text, int y, TTF_Font* font, const Color& color = COLOR_TEXT);
     int getTextWidth(const std::string& text, TTF_Font* font);
     int getTextHeight(TTF_Font* font);
+    const TextTexture* getTextTexture(const std::string& text, TTF_Font* font, const Color& color);
+    const DigitAtlas* getDigitAtlas(TTF_Font* font);
+    int drawNumber(int value, int x, int y, TTF_Font* font, const Color& color);
+    void clearTextCache();
 
     // Menu rendering methods
     void renderMenu(const game_data& game);
@@ -1,25 +1,491 @@
 #include "FontCache.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 namespace graphics::font_cache {
 
 namespace {
-std::optional<std::string>& cachedFontPath() {
-    static std::optional<std::string> s_cachedFontPath;
-    return s_cachedFontPath;
+namespace fs = std::filesystem;
+
+const char* const INDEX_HEADER = "nibbler-font-index 1";
+
+struct IndexEntry {
+    std::string path;
+    long long mtime;
+    unsigned long long size;
+    // Consumer name -> whether its loader accepted the file
+    std::map<std::string, bool> results;
+};
+
+struct State {
+    std::mutex mutex;
+    std::optional<std::string> cachedPath;
+    std::string indexPath;
+    std::vector<std::string> fontDirectories;
+    bool customConfig = false;
+    // Entries in discovery order; loaded from disk on first use
+    bool loaded = false;
+    std::vector<IndexEntry> entries;
+    std::thread revalidation;
+    bool revalidated = false;
+    std::atomic<bool> stopRevalidation{false};
+
+    // Runs when the plugin is unloaded; the thread must not outlive it
+    ~State() {
+        stopRevalidation = true;
+        if (revalidation.joinable()) {
+            revalidation.join();
+        }
+    }
+};
+
+State& state() {
+    static State s_state;
+    return s_state;
+}
+
+std::string defaultIndexPath() {
+    std::error_code ec;
+    fs::path base = fs::current_path(ec);
+    return (base / "save_data" / "font_index.txt").string();
+}
+
+std::vector<std::string> defaultFontDirectories() {
+    std::vector<std::string> directories = {"/usr/share/fonts", "/usr/local/share/fonts"};
+    if (const char* homeEnv = std::getenv("HOME")) {
+        directories.push_back((fs::path(homeEnv) / ".fonts").string());
+        directories.push_back((fs::path(homeEnv) / ".local/share/fonts").string());
+    }
+    return directories;
+}
+
+bool statFont(const std::string& path, long long& mtime, unsigned long long& size) {
+    std::error_code ec;
+    if (!fs::is_regular_file(path, ec)) {
+        return false;
+    }
+    auto writeTime = fs::last_write_time(path, ec);
+    if (ec) {
+        return false;
+    }
+    auto bytes = fs::file_size(path, ec);
+    if (ec) {
+        return false;
+    }
+    mtime = static_cast<long long>(writeTime.time_since_epoch().count());
+    size = static_cast<unsigned long long>(bytes);
+    return true;
+}
+
+bool isFontExtension(const fs::path& path) {
+    std::string ext = path.extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) {
+        return static_cast<char>(std::tolower(c));
+    });
+    return ext == ".ttf" || ext == ".otf" || ext == ".ttc";
+}
+
+// Existing font files: preferred ones in order, then each directory's
+// fonts sorted by path so the index order does not depend on readdir
+std::vector<std::string> discoverFonts(const std::vector<std::string>& preferredFonts,
+                                       const std::vector<std::string>& directories,
+                                       const std::atomic<bool>* stop) {
+    std::vector<std::string> found;
+    std::unordered_set<std::string> seen;
+    for (const std::string& path : preferredFonts) {
+        std::error_code ec;
+        if (fs::is_regular_file(path, ec) && seen.insert(path).second) {
+            found.push_back(path);
+        }
+    }
+
+    for (const std::string& dir : directories) {
+        std::error_code ec;
+        if (!fs::is_directory(dir, ec)) {
+            continue;
+        }
+        std::vector<std::string> inDirectory;
+        try {
+            for (const auto& entry : fs::recursive_directory_iterator(dir, fs::directory_options::skip_permission_denied)) {
+                if (stop && stop->load(std::memory_order_relaxed)) {
+                    return found;
+                }
+                if (entry.is_regular_file(ec) && isFontExtension(entry.path())) {
+                    inDirectory.push_back(entry.path().string());
+                }
+            }
+        } catch (const std::exception&) {
+            // Ignore directories we cannot traverse
+        }
+        std::sort(inDirectory.begin(), inDirectory.end());
+        for (std::string& path : inDirectory) {
+            if (seen.insert(path).second) {
+                found.push_back(std::move(path));
+            }
+        }
+    }
+    return found;
+}
+
+// One entry per line: mtime, size, results ("-" or name=0/1 pairs joined
+// with commas) and the path, which runs to the end of the line
+bool loadIndex(const std::string& indexPath, std::vector<IndexEntry>& entries) {
+    std::ifstream in(indexPath);
+    std::string line;
+    if (!in || !std::getline(in, line) || line != INDEX_HEADER) {
+        return false;
+    }
+    while (std::getline(in, line)) {
+        std::istringstream fields(line);
+        IndexEntry entry;
+        std::string results;
+        if (!(fields >> entry.mtime >> entry.size >> results) || fields.get() != ' ') {
+            continue;
+        }
+        std::getline(fields, entry.path);
+        if (entry.path.empty()) {
+            continue;
+        }
+        std::istringstream pairs(results == "-" ? std::string() : results);
+        std::string pair;
+        while (std::getline(pairs, pair, ',')) {
+            size_t equals = pair.find('=');
+            if (equals != std::string::npos && equals + 1 < pair.size()) {
+                entry.results[pair.substr(0, equals)] = pair[equals + 1] == '1';
+            }
+        }
+        entries.push_back(std::move(entry));
+    }
+    return true;
+}
+
+// Each plugin library links its own copy of this file and so keeps its own
+// entries. Before saving, what the other one wrote since is folded in:
+// results of consumers this copy has none for, and files only it indexed.
+void mergeSavedIndex(const std::string& indexPath, std::vector<IndexEntry>& entries) {
+    std::vector<IndexEntry> saved;
+    if (!loadIndex(indexPath, saved)) {
+        return;
+    }
+    std::unordered_map<std::string, size_t> byPath;
+    for (size_t i = 0; i < entries.size(); ++i) {
+        byPath.emplace(entries[i].path, i);
+    }
+    for (IndexEntry& other : saved) {
+        auto known = byPath.find(other.path);
+        if (known == byPath.end()) {
+            long long mtime = 0;
+            unsigned long long size = 0;
+            if (statFont(other.path, mtime, size) && mtime == other.mtime && size == other.size) {
+                byPath.emplace(other.path, entries.size());
+                entries.push_back(std::move(other));
+            }
+            continue;
+        }
+        IndexEntry& entry = entries[known->second];
+        if (entry.mtime == other.mtime && entry.size == other.size) {
+            // insert() keeps this copy's own result where both have one
+            entry.results.insert(other.results.begin(), other.results.end());
+        }
+    }
+}
+
+bool writeIndexFile(int fd, const std::string& path, const std::vector<IndexEntry>& entries) {
+    fchmod(fd, 0644);
+    close(fd);
+    std::ofstream out(path, std::ios::trunc);
+    if (!out) {
+        return false;
+    }
+    out << INDEX_HEADER << '\n';
+    for (const IndexEntry& entry : entries) {
+        std::string results;
+        for (const auto& result : entry.results) {
+            if (!results.empty()) {
+                results += ',';
+            }
+            results += result.first + '=' + (result.second ? '1' : '0');
+        }
+        out << entry.mtime << ' ' << entry.size << ' ' << (results.empty() ? "-" : results) << ' ' << entry.path
+            << '\n';
+    }
+    out.flush();
+    return static_cast<bool>(out);
+}
+
+// Merged and replaced under a lock file shared by both plugins and by
+// other running games. The new index is written to a file of its own and
+// renamed over the old one, so readers never see half of it.
+void saveIndex(const std::string& indexPath, std::vector<IndexEntry>& entries) {
+    std::error_code ec;
+    fs::path target(indexPath);
+    if (target.has_parent_path()) {
+        fs::create_directories(target.parent_path(), ec);
+    }
+    int lockFd = open((indexPath + ".lock").c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (lockFd >= 0) {
+        flock(lockFd, LOCK_EX);
+    }
+
+    mergeSavedIndex(indexPath, entries);
+    std::string temporary = indexPath + ".XXXXXX";
+    int fd = mkstemp(&temporary[0]);
+    if (fd >= 0) {
+        bool written = writeIndexFile(fd, temporary, entries);
+        if (written) {
+            fs::rename(temporary, target, ec);
+        }
+        if (!written || ec) {
+            fs::remove(temporary, ec);
+        }
+    }
+
+    if (lockFd >= 0) {
+        flock(lockFd, LOCK_UN);
+        close(lockFd);
+    }
+}
+
+// Adds paths the index does not know yet; returns true if any were new
+bool mergeDiscovered(std::vector<IndexEntry>& entries, const std::vector<std::string>& paths) {
+    std::unordered_set<std::string> known;
+    for (const IndexEntry& entry : entries) {
+        known.insert(entry.path);
+    }
+    bool added = false;
+    for (const std::string& path : paths) {
+        IndexEntry entry;
+        if (known.count(path) || !statFont(path, entry.mtime, entry.size)) {
+            continue;
+        }
+        entry.path = path;
+        entries.push_back(std::move(entry));
+        added = true;
+    }
+    return added;
+}
+
+// Re-stats every indexed file and walks the directories for new ones.
+// The slow part runs without the lock; results are merged by path.
+void revalidate() {
+    State& s = state();
+    std::vector<std::string> paths;
+    std::vector<std::string> directories;
+    {
+        std::lock_guard<std::mutex> lock(s.mutex);
+        for (const IndexEntry& entry : s.entries) {
+            paths.push_back(entry.path);
+        }
+        directories = s.fontDirectories;
+    }
+
+    struct FileState {
+        bool exists;
+        long long mtime;
+        unsigned long long size;
+    };
+    std::unordered_map<std::string, FileState> current;
+    for (const std::string& path : paths) {
+        if (s.stopRevalidation.load(std::memory_order_relaxed)) {
+            return;
+        }
+        FileState file = {false, 0, 0};
+        file.exists = statFont(path, file.mtime, file.size);
+        current[path] = file;
+    }
+    std::vector<std::string> discovered = discoverFonts({}, directories, &s.stopRevalidation);
+    if (s.stopRevalidation.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(s.mutex);
+    bool changed = false;
+    for (auto it = s.entries.begin(); it != s.entries.end();) {
+        auto file = current.find(it->path);
+        if (file == current.end()) {
+            ++it; // Added after the snapshot; already fresh
+        } else if (!file->second.exists) {
+            it = s.entries.erase(it);
+            changed = true;
+        } else {
+            if (file->second.mtime != it->mtime || file->second.size != it->size) {
+                it->mtime = file->second.mtime;
+                it->size = file->second.size;
+                it->results.clear();
+                changed = true;
+            }
+            ++it;
+        }
+    }
+    changed = mergeDiscovered(s.entries, discovered) || changed;
+    if (changed) {
+        saveIndex(s.indexPath, s.entries);
+    }
+}
+
+void ensureConfigured(State& s) {
+    if (!s.customConfig && s.indexPath.empty()) {
+        s.indexPath = defaultIndexPath();
+        s.fontDirectories = defaultFontDirectories();
+    }
+}
+
+void joinRevalidation(State& s) {
+    if (s.revalidation.joinable()) {
+        s.revalidation.join();
+    }
 }
 } // namespace
 
 const std::optional<std::string>& get() {
-    return cachedFontPath();
+    return state().cachedPath;
 }
 
 void set(const std::string& path) {
-    cachedFontPath() = path;
+    state().cachedPath = path;
 }
 
 void reset() {
-    cachedFontPath().reset();
+    State& s = state();
+    s.cachedPath.reset();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    s.loaded = false;
+    s.entries.clear();
 }
 
-} // namespace graphics::font_cache
+std::optional<std::string> resolve(const std::string& consumer, const std::vector<std::string>& preferredFonts,
+                                   const std::function<bool(const std::string&)>& tryLoad) {
+    State& s = state();
+    if (s.cachedPath) {
+        std::error_code ec;
+        if (fs::is_regular_file(*s.cachedPath, ec) && tryLoad(*s.cachedPath)) {
+            return s.cachedPath;
+        }
+    }
 
+    std::unique_lock<std::mutex> lock(s.mutex);
+    ensureConfigured(s);
+    if (!s.loaded) {
+        s.entries.clear();
+        if (!loadIndex(s.indexPath, s.entries)) {
+            s.entries.clear();
+        }
+        s.loaded = true;
+    }
+
+    std::unordered_map<std::string, size_t> preferredRank;
+    for (size_t i = 0; i < preferredFonts.size(); ++i) {
+        preferredRank.emplace(preferredFonts[i], i);
+    }
+
+    bool dirty = false;
+    bool walked = false;
+    std::optional<std::string> chosen;
+    while (!chosen) {
+        // Preferred fonts first, then the index order
+        std::vector<size_t> order(s.entries.size());
+        for (size_t i = 0; i < order.size(); ++i) {
+            order[i] = i;
+        }
+        std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+            auto rankA = preferredRank.find(s.entries[a].path);
+            auto rankB = preferredRank.find(s.entries[b].path);
+            size_t first = rankA == preferredRank.end() ? preferredFonts.size() : rankA->second;
+            size_t second = rankB == preferredRank.end() ? preferredFonts.size() : rankB->second;
+            return first < second;
+        });
+
+        // Pass 0 retries what this consumer accepted before, pass 1 tries
+        // what it never saw. A changed file loses its old results.
+        for (int pass = 0; pass < 2 && !chosen; ++pass) {
+            for (size_t index : order) {
+                IndexEntry& entry = s.entries[index];
+                auto result = entry.results.find(consumer);
+                bool known = result != entry.results.end();
+                if (pass == 0 ? !(known && result->second) : known) {
+                    continue;
+                }
+                long long mtime = 0;
+                unsigned long long size = 0;
+                if (!statFont(entry.path, mtime, size)) {
+                    continue; // Gone; revalidation drops it
+                }
+                if (mtime != entry.mtime || size != entry.size) {
+                    entry.mtime = mtime;
+                    entry.size = size;
+                    entry.results.clear();
+                    dirty = true;
+                    if (pass == 0) {
+                        continue;
+                    }
+                }
+                bool accepted = tryLoad(entry.path);
+                if (!known || result->second != accepted) {
+                    entry.results[consumer] = accepted;
+                    dirty = true;
+                }
+                if (accepted) {
+                    chosen = entry.path;
+                    break;
+                }
+            }
+        }
+
+        if (chosen || walked) {
+            break;
+        }
+        // Nothing usable indexed: the slow walk, normally only on first run
+        walked = true;
+        dirty = mergeDiscovered(s.entries, discoverFonts(preferredFonts, s.fontDirectories, nullptr)) || dirty;
+    }
+
+    if (dirty) {
+        saveIndex(s.indexPath, s.entries);
+    }
+    if (chosen) {
+        s.cachedPath = chosen;
+    }
+    if (!walked && !s.revalidated && !s.revalidation.joinable()) {
+        s.revalidated = true;
+        s.revalidation = std::thread(revalidate);
+    }
+    return chosen;
+}
+
+void configure(const std::string& indexPath, const std::vector<std::string>& fontDirectories) {
+    State& s = state();
+    s.stopRevalidation = true;
+    joinRevalidation(s);
+    s.stopRevalidation = false;
+
+    std::lock_guard<std::mutex> lock(s.mutex);
+    s.customConfig = !indexPath.empty();
+    s.indexPath = indexPath;
+    s.fontDirectories = fontDirectories;
+    s.loaded = false;
+    s.entries.clear();
+    s.revalidated = false;
+    s.cachedPath.reset();
+}
+
+void waitForRevalidation() {
+    joinRevalidation(state());
+}
+
+} // namespace graphics::font_cache
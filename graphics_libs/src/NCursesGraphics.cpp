@@ -2,12 +2,20 @@
 #include "../../game_data.hpp"
 #include <algorithm>
 #include <cstdlib>
+#include <poll.h>
+#include <unistd.h>
 
 NCursesGraphics::NCursesGraphics()
-    : _initialized(false), _shouldContinue(true), _frameRate(60),
+    : _initialized(false), _suspended(false), _shouldContinue(true), _frameRate(60),
       _gameWindow(nullptr), _switchMessageTimer(0), _infoWindow(nullptr),
-      _menuSystem(nullptr) {
+      _menuSystem(nullptr), _layoutValid(false), _showingMenu(false), _layoutTermWidth(0),
+      _layoutTermHeight(0), _layoutBoardWidth(0), _layoutBoardHeight(0), _layoutBorders(false) {
     clearError();
+    for (int tile = 0; tile <= static_cast<int>(RenderTile::TILE_SNAKE_BODY); ++tile) {
+        RenderTile renderTile = static_cast<RenderTile>(tile);
+        _tileGlyphs[tile] = static_cast<chtype>(static_cast<unsigned char>(getCharFromTile(renderTile))) |
+                            COLOR_PAIR(getColorFromTile(renderTile));
+    }
 }
 
 NCursesGraphics::~NCursesGraphics() {
@@ -60,6 +68,7 @@ int NCursesGraphics::initialize() {
     refresh();  // Final refresh
 
     _initialized = true;
+    _layoutValid = false;
 
     // Force input readiness
     forceInputReadiness();
@@ -83,11 +92,45 @@ void NCursesGraphics::shutdown() {
     }
 
     // Restore terminal
-    endwin();
+    if (!_suspended) {
+        endwin();
+    }
+    _suspended = false;
     _initialized = false;
 }
 
+bool NCursesGraphics::suspend() {
+    if (!_initialized || _suspended) {
+        return _initialized;
+    }
+    // Hands the terminal back but keeps the screen and windows, so
+    // resume() is a repaint rather than a new initscr()
+    endwin();
+    _suspended = true;
+    return true;
+}
+
+int NCursesGraphics::resume() {
+    if (!_initialized) {
+        return 1;
+    }
+    if (_suspended) {
+        // The first refresh after endwin() re-enters curses mode; the
+        // terminal may have been written to meanwhile, so repaint it all
+        clearok(curscr, TRUE);
+        refresh();
+        _suspended = false;
+    }
+    forceInputReadiness();
+    return 0;
+}
+
 void NCursesGraphics::render(const game_data& game) {
+    game.build_render_snapshot(_compatSnapshot);
+    render(_compatSnapshot);
+}
+
+void NCursesGraphics::render(const RenderSnapshot& snapshot) {
     if (!_initialized) {
         return;
     }
@@ -97,24 +140,36 @@ void NCursesGraphics::render(const game_data& game) {
     if (wantAlt != _altColorsActive) {
         _altColorsActive = wantAlt;
         initializeColors();
+        _layoutValid = false;
     }
 
-    // Clear screen
-    clear();
-
-    // Check if we should render menu instead of game
+    // Check if we should render menu instead of game. Menu pages are
+    // redrawn in full but only erase() the virtual screen, so refresh()
+    // still sends just what changed; clear() is kept for transitions.
     if (_menuSystem && _menuSystem->getCurrentState() != MenuState::IN_GAME) {
-        renderMenu(game);
+        if (!_showingMenu || !_layoutValid) {
+            clear();
+        } else {
+            erase();
+        }
+        _showingMenu = true;
+        _layoutValid = true;
+        if (snapshot.source)
+            renderMenu(*snapshot.source);
         refresh();
         return;
     }
+    if (_showingMenu) {
+        _showingMenu = false;
+        _layoutValid = false;
+    }
 
     // Get terminal size
     int termHeight, termWidth;
     getmaxyx(stdscr, termHeight, termWidth);
 
-    size_t gameWidth = game.get_width();
-    size_t gameHeight = game.get_height();
+    size_t gameWidth = static_cast<size_t>(snapshot.width);
+    size_t gameHeight = static_cast<size_t>(snapshot.height);
 
     // Calculate centering offsets
     int startY = (termHeight - static_cast<int>(gameHeight) - 4) / 2; // -4 for borders and info
@@ -130,44 +185,29 @@ void NCursesGraphics::render(const game_data& game) {
     int tileOffsetX = startX + (showBorders ? 1 : 0);
     int tileOffsetY = startY + (showBorders ? 1 : 0);
 
-    // Draw game border (optional)
-    if (showBorders) {
-        attron(COLOR_PAIR(COLOR_BORDER));
-        // Top border
-        mvhline(startY, startX, ACS_HLINE, static_cast<int>(gameWidth) + 2);
-        mvaddch(startY, startX, ACS_ULCORNER);
-        mvaddch(startY, startX + static_cast<int>(gameWidth) + 1, ACS_URCORNER);
-    }
-
-    // Side borders and game area
-    for (size_t y = 0; y < gameHeight; ++y) {
+    // A resize, a new board or a border toggle moves everything: start
+    // over from a cleared screen and an empty shadow
+    bool layoutChanged = !_layoutValid || termWidth != _layoutTermWidth || termHeight != _layoutTermHeight ||
+                         snapshot.width != _layoutBoardWidth || snapshot.height != _layoutBoardHeight ||
+                         showBorders != _layoutBorders;
+    if (layoutChanged) {
+        clear();
+        _shadow.assign(gameWidth * gameHeight, 0);
+        _layoutValid = true;
+        _layoutTermWidth = termWidth;
+        _layoutTermHeight = termHeight;
+        _layoutBoardWidth = snapshot.width;
+        _layoutBoardHeight = snapshot.height;
+        _layoutBorders = showBorders;
         if (showBorders) {
-            mvaddch(startY + 1 + static_cast<int>(y), startX, ACS_VLINE);
-            mvaddch(startY + 1 + static_cast<int>(y), startX + static_cast<int>(gameWidth) + 1, ACS_VLINE);
-        }
-
-        // Draw game tiles
-        for (size_t x = 0; x < gameWidth; ++x) {
-            char ch = getCharFromGameTile(static_cast<int>(x), static_cast<int>(y), game);
-            int colorPair = getColorFromGameTile(static_cast<int>(x), static_cast<int>(y), game);
-
-            attron(COLOR_PAIR(colorPair));
-            mvaddch(tileOffsetY + static_cast<int>(y), tileOffsetX + static_cast<int>(x), ch);
-            attroff(COLOR_PAIR(colorPair));
+            drawBoardFrame(startY, startX, snapshot.width, snapshot.height);
         }
     }
 
-    // Bottom border
-    if (showBorders) {
-        attron(COLOR_PAIR(COLOR_BORDER));
-        mvhline(startY + static_cast<int>(gameHeight) + 1, startX, ACS_HLINE, static_cast<int>(gameWidth) + 2);
-        mvaddch(startY + static_cast<int>(gameHeight) + 1, startX, ACS_LLCORNER);
-        mvaddch(startY + static_cast<int>(gameHeight) + 1, startX + static_cast<int>(gameWidth) + 1, ACS_LRCORNER);
-        attroff(COLOR_PAIR(COLOR_BORDER));
-    }
+    drawBoardCells(snapshot, tileOffsetY, tileOffsetX, layoutChanged || snapshot.fullRedraw);
 
     // Draw game info
-    drawInfo(game);
+    drawInfo(snapshot);
 
     // No switch message displayed
 
@@ -175,6 +215,71 @@ void NCursesGraphics::render(const game_data& game) {
     refresh();
 }
 
+void NCursesGraphics::drawBoardFrame(int startY, int startX, int width, int height) {
+    attron(COLOR_PAIR(COLOR_BORDER));
+    mvhline(startY, startX, ACS_HLINE, width + 2);
+    mvaddch(startY, startX, ACS_ULCORNER);
+    mvaddch(startY, startX + width + 1, ACS_URCORNER);
+    mvvline(startY + 1, startX, ACS_VLINE, height);
+    mvvline(startY + 1, startX + width + 1, ACS_VLINE, height);
+    mvhline(startY + height + 1, startX, ACS_HLINE, width + 2);
+    mvaddch(startY + height + 1, startX, ACS_LLCORNER);
+    mvaddch(startY + height + 1, startX + width + 1, ACS_LRCORNER);
+    attroff(COLOR_PAIR(COLOR_BORDER));
+}
+
+// Writes the cells that differ from the shadow. A full pass compares every
+// cell and writes each changed run of a row with one mvaddchnstr(); an
+// incremental pass only looks at the snapshot's dirty cells.
+void NCursesGraphics::drawBoardCells(const RenderSnapshot& snapshot, int offsetY, int offsetX, bool fullPass) {
+    const int width = snapshot.width;
+    const int height = snapshot.height;
+    const size_t cellCount = _shadow.size();
+    static const int TILE_COUNT = static_cast<int>(RenderTile::TILE_SNAKE_BODY) + 1;
+
+    if (!fullPass) {
+        for (uint32_t cell : snapshot.dirtyCells) {
+            if (cell >= cellCount) {
+                continue;
+            }
+            int tile = std::min(static_cast<int>(snapshot.tiles[cell]), TILE_COUNT - 1);
+            chtype glyph = _tileGlyphs[tile];
+            if (_shadow[cell] == glyph) {
+                continue;
+            }
+            _shadow[cell] = glyph;
+            mvaddch(offsetY + static_cast<int>(cell) / width, offsetX + static_cast<int>(cell) % width, glyph);
+        }
+        return;
+    }
+
+    _runBuffer.resize(static_cast<size_t>(width));
+    for (int y = 0; y < height; ++y) {
+        size_t rowStart = static_cast<size_t>(y) * static_cast<size_t>(width);
+        int x = 0;
+        while (x < width) {
+            int runStart = x;
+            int runLength = 0;
+            while (x < width) {
+                size_t cell = rowStart + static_cast<size_t>(x);
+                int tile = std::min(static_cast<int>(snapshot.tiles[cell]), TILE_COUNT - 1);
+                chtype glyph = _tileGlyphs[tile];
+                if (_shadow[cell] == glyph) {
+                    break;
+                }
+                _shadow[cell] = glyph;
+                _runBuffer[static_cast<size_t>(runLength++)] = glyph;
+                ++x;
+            }
+            if (runLength > 0) {
+                mvaddchnstr(offsetY + y, offsetX + runStart, _runBuffer.data(), runLength);
+            } else {
+                ++x;
+            }
+        }
+    }
+}
+
 GameKey NCursesGraphics::getInput() {
     if (!_initialized) {
         return GameKey::NONE;
@@ -284,6 +389,19 @@ GameKey NCursesGraphics::getInput() {
     }
 }
 
+int NCursesGraphics::waitForInput(int timeoutMs) {
+    if (!_initialized) {
+        return -1;
+    }
+    // getch() is non-blocking, so wait on the terminal itself
+    struct pollfd terminal = {STDIN_FILENO, POLLIN, 0};
+    int ready = poll(&terminal, 1, timeoutMs);
+    if (ready < 0) {
+        return -1;
+    }
+    return ready > 0 ? 1 : 0;
+}
+
 const char* NCursesGraphics::getName() const {
     return "NCurses Graphics";
 }
@@ -348,74 +466,69 @@ void NCursesGraphics::initializeColors() {
     }
 }
 
-void NCursesGraphics::drawInfo(const game_data& game) {
+void NCursesGraphics::drawInfo(const RenderSnapshot& snapshot) {
     int termHeight, termWidth;
     getmaxyx(stdscr, termHeight, termWidth);
 
-    // Draw info at the bottom
+    // Draw info at the bottom. The screen is not cleared between frames,
+    // so the numbers are padded to overwrite longer old values.
     attron(COLOR_PAIR(COLOR_INFO));
 
     // Snake length
-    mvprintw(termHeight - 4, 2, "Snake Length: %d", game.get_snake_length(0));
+    mvprintw(termHeight - 4, 2, "Snake Length: %-6d", snapshot.snakeLength[0]);
 
     // FPS display (toggleable)
     if (_menuSystem && _menuSystem->getSettings().showFPS) {
-        mvprintw(termHeight - 4, 28, "| FPS: %d", _frameRate);
+        mvprintw(termHeight - 4, 28, "| FPS: %-4d", _frameRate);
     }
 
     attroff(COLOR_PAIR(COLOR_INFO));
 }
 
-char NCursesGraphics::getCharFromGameTile(int x, int y, const game_data& game) {
-    // Check layer 2 first (snake and food)
-    int layer2Value = game.get_map_value(x, y, 2);
-    if (layer2Value == FOOD) {
-        return '*';  // Food
-    } else if (layer2Value == FIRE_FOOD) {
-        return 'F';  // Fire food
-    } else if (layer2Value == FROSTY_FOOD) {
-        return 'I';  // Frosty food
-    } else if (layer2Value >= SNAKE_HEAD_PLAYER_1) {
-        return (layer2Value % 1000000 == 1) ? '@' : 'o';
-    }
-
-    // Check layer 0 (terrain)
-    int layer0Value = game.get_map_value(x, y, 0);
-    if (layer0Value == GAME_TILE_WALL) {
-        return '#'; // Wall
-    } else if (layer0Value == GAME_TILE_ICE) {
-        return '~';  // Ice
-    } else if (layer0Value == GAME_TILE_FIRE) {
-        return '^';  // Fire tile
+char NCursesGraphics::getCharFromTile(RenderTile tile) {
+    switch (tile) {
+    case RenderTile::TILE_FOOD:
+        return '*';
+    case RenderTile::TILE_FIRE_FOOD:
+        return 'F';
+    case RenderTile::TILE_FROSTY_FOOD:
+        return 'I';
+    case RenderTile::TILE_SNAKE_HEAD:
+        return '@';
+    case RenderTile::TILE_SNAKE_BODY:
+        return 'o';
+    case RenderTile::TILE_WALL:
+        return '#';
+    case RenderTile::TILE_ICE:
+        return '~';
+    case RenderTile::TILE_FIRE:
+        return '^';
+    default:
+        return ' ';
     }
-
-    return ' '; // Empty space
 }
 
-int NCursesGraphics::getColorFromGameTile(int x, int y, const game_data& game) {
-    // Check layer 2 first (snake and food)
-    int layer2Value = game.get_map_value(x, y, 2);
-    if (layer2Value == FOOD) {
+int NCursesGraphics::getColorFromTile(RenderTile tile) {
+    switch (tile) {
+    case RenderTile::TILE_FOOD:
         return COLOR_FOOD;
-    } else if (layer2Value == FIRE_FOOD) {
+    case RenderTile::TILE_FIRE_FOOD:
         return COLOR_FIRE_FOOD;
-    } else if (layer2Value == FROSTY_FOOD) {
+    case RenderTile::TILE_FROSTY_FOOD:
         return COLOR_FROSTY_FOOD;
-    } else if (layer2Value >= SNAKE_HEAD_PLAYER_1) {
-        return (layer2Value % 1000000 == 1) ? COLOR_SNAKE_HEAD : COLOR_SNAKE_BODY;
-    }
-
-    // Check layer 0 (terrain)
-    int layer0Value = game.get_map_value(x, y, 0);
-    if (layer0Value == GAME_TILE_WALL) {
+    case RenderTile::TILE_SNAKE_HEAD:
+        return COLOR_SNAKE_HEAD;
+    case RenderTile::TILE_SNAKE_BODY:
+        return COLOR_SNAKE_BODY;
+    case RenderTile::TILE_WALL:
         return COLOR_WALL;
-    } else if (layer0Value == GAME_TILE_ICE) {
+    case RenderTile::TILE_ICE:
         return COLOR_ICE;
-    } else if (layer0Value == GAME_TILE_FIRE) {
+    case RenderTile::TILE_FIRE:
         return COLOR_FIRE_TILE;
+    default:
+        return 0;
     }
-
-    return 0; // Default color
 }
 
 void NCursesGraphics::setError(const std::string& error) {
@@ -436,17 +549,10 @@ void NCursesGraphics::forceInputReadiness() {
         return;
     }
 
-    // Force multiple refreshes to ensure terminal is ready
-    for (int i = 0; i < 3; i++) {
-        flushinp(); // Clear input buffer
-        refresh();  // Refresh display
-        doupdate(); // Force update
-
-        // Small delay between refreshes
-        napms(10); // 10ms delay
-    }
-
-    // Final input buffer clear
+    // doupdate() returns once the terminal has the screen, so one pass is
+    // enough; drop keys typed into the terminal while it was inactive
+    refresh();
+    doupdate();
     flushinp();
 }
 
@@ -703,6 +809,13 @@ void NCursesGraphics::renderGameOverScreen() {
 }
 
 // C interface for dynamic library loading
+// The board is limited by the terminal size, which can change at any time
+const GraphicsCapabilities NCursesGraphics::CAPABILITIES = {
+    GRAPHICS_ABI_VERSION, sizeof(GraphicsCapabilities),
+    GRAPHICS_CAP_SNAPSHOT_RENDER | GRAPHICS_CAP_INCREMENTAL_RENDER | GRAPHICS_CAP_TERMINAL,
+    0, 0, 0
+};
+
 extern "C" {
 IGraphicsLibrary* createGraphicsLibrary() {
     return new NCursesGraphics();
@@ -719,4 +832,8 @@ const char* getLibraryName() {
 const char* getLibraryVersion() {
     return "1.0.0";
 }
+
+const GraphicsCapabilities* getGraphicsCapabilities() {
+    return &NCursesGraphics::CAPABILITIES;
+}
 }
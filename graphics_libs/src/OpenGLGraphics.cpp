@@ -7,14 +7,12 @@
 #include <cstring>
 #include <thread>
 #include <chrono>
-#include <filesystem>
 #include <cmath>
 #include <vector>
-#include <unordered_set>
 #include <algorithm>
-#include <optional>
-#include <cstdlib>
-#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
 
 // Helper macro to safely delete OpenGL textures
 static void safeDeleteTexture(unsigned int &tex) {
@@ -27,14 +25,48 @@ static void safeDeleteTexture(unsigned int &tex) {
 namespace {
 namespace fs = std::filesystem;
 
-bool isUsableFontFile(const fs::path& path) {
+const int GLYPH_ATLAS_WIDTH = 512;
+const char GLYPH_CACHE_MAGIC[8] = {'N', 'B', 'G', 'L', 'Y', 'P', 'H', '1'};
+
+template <typename T>
+bool readPod(std::istream& in, T& value) {
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+template <typename T>
+void writePod(std::ostream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+// Everything the rasterised atlas depends on; a changed font file or
+// FreeType release makes old cache files miss. Empty if the font cannot
+// be stat'ed.
+std::string glyphCacheKey(const std::string& fontPath, int pixelSize) {
     std::error_code ec;
-    return fs::exists(path, ec) && fs::is_regular_file(path, ec);
+    auto writeTime = fs::last_write_time(fontPath, ec);
+    if (ec) {
+        return std::string();
+    }
+    auto bytes = fs::file_size(fontPath, ec);
+    if (ec) {
+        return std::string();
+    }
+    std::ostringstream key;
+    key << fontPath << '\n' << writeTime.time_since_epoch().count() << '\n' << bytes << '\n' << pixelSize
+        << "px\nfreetype " << FREETYPE_MAJOR << '.' << FREETYPE_MINOR << '.' << FREETYPE_PATCH;
+    return key.str();
+}
+
+std::string glyphCachePath(const std::string& fontPath, int pixelSize) {
+    std::error_code ec;
+    std::ostringstream name;
+    name << "opengl-" << std::hex << std::hash<std::string>()(fontPath) << std::dec << '-' << pixelSize << ".atlas";
+    return (fs::current_path(ec) / "save_data" / "glyph_cache" / name.str()).string();
 }
 
-template <typename TryLoad>
-std::optional<std::string> resolveFontPath(TryLoad&& tryLoad) {
-    static const std::vector<std::string> priorityFonts = {
+// Tried first; font_cache finds the rest through its index
+const std::vector<std::string>& preferredFonts() {
+    static const std::vector<std::string> fonts = {
         "/usr/share/fonts/truetype/liberation/LiberationSans-Regular.ttf",
         "/usr/share/fonts/truetype/liberation/LiberationSansNarrow-Regular.ttf",
         "/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf",
@@ -56,118 +88,7 @@ std::optional<std::string> resolveFontPath(TryLoad&& tryLoad) {
         "C:/Windows/Fonts/arial.ttf",
         "C:/Windows/Fonts/segoeui.ttf"
     };
-
-    static const std::vector<std::string> fontDirectories = {
-        "/usr/share/fonts",
-        "/usr/local/share/fonts",
-        "/usr/share/fonts/truetype",
-        "/usr/share/fonts/opentype",
-        "/usr/share/fonts/TTF",
-        "/usr/share/fonts/dejavu",
-        "/usr/share/fonts/liberation",
-        "/usr/share/fonts/google-noto",
-        "/usr/share/fonts/gnu-free",
-        "/usr/share/fonts/freefont",
-        "/usr/share/fonts/cantarell",
-        "/usr/share/fonts/roboto",
-        "/usr/share/fonts/adobe-source-sans-pro",
-        "/usr/share/fonts/adobe-source-code-pro",
-        "/usr/share/fonts/fedora",
-        "/usr/share/fonts/OfL",
-        "/usr/share/fonts/truetype/msttcorefonts",
-        "/usr/share/fonts/truetype/droid",
-        "/usr/share/fonts/truetype/nimbus",
-        "/usr/share/fonts/truetype/abyssinica",
-        "/usr/share/fonts/truetype/source-sans-pro",
-        "/usr/share/fonts/truetype/hack",
-        "/usr/share/fonts/truetype/fira",
-        "/usr/share/fonts/truetype/cantarell"
-    };
-
-    std::unordered_set<std::string> seen;
-    seen.reserve(priorityFonts.size() * 2);
-
-    auto considerCandidate = [&](const std::string& path) -> std::optional<std::string> {
-        if (path.empty()) {
-            return std::nullopt;
-        }
-        if (!seen.insert(path).second) {
-            return std::nullopt;
-        }
-        if (!isUsableFontFile(path)) {
-            return std::nullopt;
-        }
-        if (tryLoad(path)) {
-            return path;
-        }
-        return std::nullopt;
-    };
-
-    auto searchDirectory = [&](const fs::path& dir) -> std::optional<std::string> {
-        std::error_code ec;
-        if (!fs::exists(dir, ec) || !fs::is_directory(dir, ec)) {
-            return std::nullopt;
-        }
-        try {
-            for (const auto& entry : fs::recursive_directory_iterator(dir, fs::directory_options::skip_permission_denied)) {
-                if (!entry.is_regular_file()) {
-                    continue;
-                }
-                auto ext = entry.path().extension().string();
-                std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) {
-                    return static_cast<char>(std::tolower(c));
-                });
-                if (ext == ".ttf" || ext == ".otf" || ext == ".ttc") {
-                    if (auto chosen = considerCandidate(entry.path().string())) {
-                        return chosen;
-                    }
-                }
-            }
-        } catch (const std::exception&) {
-            // Ignore directories we cannot traverse
-        }
-        return std::nullopt;
-    };
-
-    for (const auto& path : priorityFonts) {
-        if (auto chosen = considerCandidate(path)) {
-            return chosen;
-        }
-    }
-
-    const char* homeEnv = std::getenv("HOME");
-    if (homeEnv) {
-        fs::path homePath(homeEnv);
-        if (auto chosen = considerCandidate((homePath / ".fonts/DejaVuSans.ttf").string())) {
-            return chosen;
-        }
-        if (auto chosen = considerCandidate((homePath / ".fonts/Arial.ttf").string())) {
-            return chosen;
-        }
-        if (auto chosen = considerCandidate((homePath / ".local/share/fonts/DejaVuSans.ttf").string())) {
-            return chosen;
-        }
-        if (auto chosen = considerCandidate((homePath / ".local/share/fonts/Arial.ttf").string())) {
-            return chosen;
-        }
-    }
-
-    for (const auto& dir : fontDirectories) {
-        if (auto chosen = searchDirectory(dir)) {
-            return chosen;
-        }
-    }
-
-    if (homeEnv) {
-        if (auto chosen = searchDirectory(fs::path(homeEnv) / ".fonts")) {
-            return chosen;
-        }
-        if (auto chosen = searchDirectory(fs::path(homeEnv) / ".local/share/fonts")) {
-            return chosen;
-        }
-    }
-
-    return std::nullopt;
+    return fonts;
 }
 } // namespace
 
@@ -196,7 +117,7 @@ const OpenGLGraphics::Color OpenGLGraphics::ALT_COLOR_TEXT(0.94f, 0.94f, 0.94f);
 
 OpenGLGraphics::OpenGLGraphics()
         : _window(nullptr), _initialized(false), _shouldContinue(true), _targetFPS(60),
-            _menuSystem(nullptr), _switchMessageTimer(0), _lastKeyPressed(GameKey::NONE), _keyConsumed(true),
+            _menuSystem(nullptr), _switchMessageTimer(0),
             _fontInitialized(false) {
 }
 
@@ -293,12 +214,48 @@ void OpenGLGraphics::shutdown() {
     _switchMessage.clear();
     _switchMessageTimer = 0;
     _targetFPS = 60;
+    _pendingKeys.clear();
+    _quadVertices.clear();
+    _quadColors.clear();
+    _textVertices.clear();
+    _textColors.clear();
+    _boardValid = false;
     _initialized = false;
 
     clearError();
 }
 
+bool OpenGLGraphics::suspend() {
+    if (!_initialized || !_window) {
+        return false;
+    }
+    // The context, font textures and GLFW itself stay alive
+    glfwHideWindow(_window);
+    glfwPollEvents();
+    _pendingKeys.clear();
+    return true;
+}
+
+int OpenGLGraphics::resume() {
+    if (!_initialized || !_window) {
+        return 1;
+    }
+    glfwShowWindow(_window);
+    glfwFocusWindow(_window);
+    // Another library may have made its own context current meanwhile
+    glfwMakeContextCurrent(_window);
+    glfwPollEvents();
+    _pendingKeys.clear();
+    _shouldContinue = true;
+    return 0;
+}
+
 void OpenGLGraphics::render(const game_data& game) {
+    game.build_render_snapshot(_compatSnapshot);
+    render(_compatSnapshot);
+}
+
+void OpenGLGraphics::render(const RenderSnapshot& snapshot) {
     if (!_initialized || !_window) {
         return;
     }
@@ -312,6 +269,11 @@ void OpenGLGraphics::render(const game_data& game) {
 
     // Handle different menu states
     if (_menuSystem) {
+        // Menu frames skip the dirty lists, so the board is rebuilt in full
+        // when the game shows again
+        if (_menuSystem->getCurrentState() != MenuState::IN_GAME) {
+            _boardValid = false;
+        }
         switch (_menuSystem->getCurrentState()) {
         case MenuState::MAIN_MENU:
             renderMainMenu();
@@ -329,7 +291,8 @@ void OpenGLGraphics::render(const game_data& game) {
             renderGameOverScreen();
             break;
         case MenuState::ACHIEVEMENTS_PAGE:
-            renderAchievementsPage(game);
+            if (snapshot.source)
+                renderAchievementsPage(*snapshot.source);
             break;
         case MenuState::EXIT_REQUESTED:
             // Handle exit - could show a "closing..." message
@@ -338,59 +301,28 @@ void OpenGLGraphics::render(const game_data& game) {
             // Render game
             {
                 int offsetX, offsetY, cellSize;
-                calculateGameArea(game, offsetX, offsetY, cellSize);
+                calculateGameArea(snapshot, offsetX, offsetY, cellSize);
 
                 // Pick palette
                 bool useAlt = useAltPalette;
                 const Color& border = useAlt ? ALT_COLOR_BORDER : COLOR_BORDER;
-                const Color& head   = useAlt ? ALT_COLOR_SNAKE_HEAD : COLOR_SNAKE_HEAD;
-                const Color& body   = useAlt ? ALT_COLOR_SNAKE_BODY : COLOR_SNAKE_BODY;
-                const Color& food   = useAlt ? ALT_COLOR_FOOD : COLOR_FOOD;
-                const Color& ice    = useAlt ? ALT_COLOR_ICE_TILE : COLOR_ICE_TILE;
 
                 // Draw game border (toggleable)
                 bool showBorders = _menuSystem && _menuSystem->getSettings().showBorders;
-                int boardWidthPx = static_cast<int>(game.get_width() * cellSize);
-                int boardHeightPx = static_cast<int>(game.get_height() * cellSize);
+                int boardWidthPx = snapshot.width * cellSize;
+                int boardHeightPx = snapshot.height * cellSize;
                 if (showBorders) {
                     drawRectangle(offsetX - 2, offsetY - 2, boardWidthPx + 4, boardHeightPx + 4, border);
                 }
                 drawRectangle(offsetX, offsetY, boardWidthPx, boardHeightPx, bgc);
 
-                // Draw game board
-                for (size_t y = 0; y < game.get_height(); ++y) {
-                    for (size_t x = 0; x < game.get_width(); ++x) {
-                        int drawX = offsetX + x * cellSize;
-                        int drawY = offsetY + y * cellSize;
-
-                        // Check layer 2 first (snake and food)
-                        int layer2Value = game.get_map_value(static_cast<int>(x), static_cast<int>(y), 2);
-                        if (layer2Value == FOOD) {
-                            drawRectangle(drawX + 2, drawY + 2, cellSize - 4, cellSize - 4, food);
-                        } else if (layer2Value == FIRE_FOOD) {
-                            drawRectangle(drawX + 2, drawY + 2, cellSize - 4, cellSize - 4, COLOR_FIRE_FOOD);
-                        } else if (layer2Value == FROSTY_FOOD) {
-                            drawRectangle(drawX + 2, drawY + 2, cellSize - 4, cellSize - 4, COLOR_FROSTY_FOOD);
-                        } else if (layer2Value >= SNAKE_HEAD_PLAYER_1) {
-                            const Color& color = (layer2Value % 1000000 == 1) ? head : body;
-                            drawRectangle(drawX, drawY, cellSize, cellSize, color);
-                        } else {
-                            // Check layer 0 (terrain)
-                            int layer0Value = game.get_map_value(static_cast<int>(x), static_cast<int>(y), 0);
-                            if (layer0Value == GAME_TILE_WALL) {
-                                drawRectangle(drawX, drawY, cellSize, cellSize, border);
-                            } else if (layer0Value == GAME_TILE_ICE) {
-                                drawRectangle(drawX, drawY, cellSize, cellSize, ice);
-                            } else if (layer0Value == GAME_TILE_FIRE) {
-                                drawRectangle(drawX, drawY, cellSize, cellSize, COLOR_FIRE_TILE);
-                            }
-                            // Empty space - background already drawn
-                        }
-                    }
-                }
+                // Draw game board: one draw call over the retained cell quads
+                updateBoardGeometry(snapshot, offsetX, offsetY, cellSize, useAlt);
+                flushBatches();
+                drawBoard();
 
                 // Draw score and optional FPS
-                std::string scoreText = "Length: " + std::to_string(game.get_snake_length(0));
+                std::string scoreText = "Length: " + std::to_string(snapshot.snakeLength[0]);
                 drawText(scoreText, 20, 20, textColor);
                 if (_menuSystem && _menuSystem->getSettings().showFPS) {
                     drawText(std::string("FPS: ") + std::to_string(_targetFPS), 20, 44, textColor, 0.8f);
@@ -419,6 +351,7 @@ void OpenGLGraphics::render(const game_data& game) {
     }
 
     // Swap buffers and poll events
+    flushBatches();
     glfwSwapBuffers(_window);
     glfwPollEvents();
 
@@ -433,13 +366,50 @@ GameKey OpenGLGraphics::getInput() {
         return GameKey::NONE;
     }
 
-    // Check if we have a key that hasn't been consumed yet
-    if (!_keyConsumed) {
-        _keyConsumed = true;
-        return _lastKeyPressed;
+    if (_pendingKeys.empty()) {
+        return GameKey::NONE;
+    }
+    GameKey key = _pendingKeys.front().key;
+    _pendingKeys.pop_front();
+    return key;
+}
+
+int OpenGLGraphics::pollInputEvents(InputEvent* events, int maxEvents) {
+    if (!_initialized || !_window) {
+        return 0;
+    }
+    int count = 0;
+    while (count < maxEvents && !_pendingKeys.empty()) {
+        events[count++] = _pendingKeys.front();
+        _pendingKeys.pop_front();
+    }
+    return count;
+}
+
+int OpenGLGraphics::waitForInput(int timeoutMs) {
+    if (!_initialized || !_window) {
+        return -1;
+    }
+    if (_pendingKeys.empty()) {
+        // Runs the key callback for anything that arrives meanwhile
+        glfwWaitEventsTimeout(timeoutMs / 1000.0);
+    }
+    if (glfwWindowShouldClose(_window)) {
+        _shouldContinue = false;
+        return 1;
     }
+    return _pendingKeys.empty() ? 0 : 1;
+}
 
-    return GameKey::NONE;
+void OpenGLGraphics::queueKey(GameKey key) {
+    if (_pendingKeys.size() >= MAX_PENDING_KEYS) {
+        _pendingKeys.pop_front();
+    }
+    InputEvent event;
+    event.key = key;
+    event.timestampNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    _pendingKeys.push_back(event);
 }
 
 bool OpenGLGraphics::shouldContinue() const {
@@ -458,6 +428,15 @@ void OpenGLGraphics::setFrameRate(int fps) {
     _targetFPS = fps;
 }
 
+void OpenGLGraphics::setVsync(bool enabled) {
+    if (!_window) {
+        return;
+    }
+    // The swap interval belongs to the current context
+    glfwMakeContextCurrent(_window);
+    glfwSwapInterval(enabled ? 1 : 0);
+}
+
 void OpenGLGraphics::setMenuSystem(MenuSystem* menuSystem) {
     _menuSystem = menuSystem;
 }
@@ -502,9 +481,9 @@ GameKey OpenGLGraphics::translateGLFWKey(int key) {
     }
 }
 
-void OpenGLGraphics::calculateGameArea(const game_data& game, int& offsetX, int& offsetY, int& cellSize) {
-    size_t gameWidth = game.get_width();
-    size_t gameHeight = game.get_height();
+void OpenGLGraphics::calculateGameArea(const RenderSnapshot& snapshot, int& offsetX, int& offsetY, int& cellSize) {
+    size_t gameWidth = static_cast<size_t>(snapshot.width);
+    size_t gameHeight = static_cast<size_t>(snapshot.height);
 
     int maxCellWidth = (WINDOW_WIDTH - 40) / static_cast<int>(gameWidth);
     int maxCellHeight = (WINDOW_HEIGHT - 100) / static_cast<int>(gameHeight);
@@ -520,13 +499,165 @@ void OpenGLGraphics::calculateGameArea(const game_data& game, int& offsetX, int&
 }
 
 void OpenGLGraphics::drawRectangle(int x, int y, int width, int height, const Color& color) {
-    glColor4f(color.r, color.g, color.b, color.a);
-    glBegin(GL_QUADS);
-    glVertex2f(x, y);
-    glVertex2f(x + width, y);
-    glVertex2f(x + width, y + height);
-    glVertex2f(x, y + height);
-    glEnd();
+    // Text queued earlier has to land underneath this rectangle
+    flushText();
+    const float corners[8] = {
+        static_cast<float>(x),         static_cast<float>(y),
+        static_cast<float>(x + width), static_cast<float>(y),
+        static_cast<float>(x + width), static_cast<float>(y + height),
+        static_cast<float>(x),         static_cast<float>(y + height)
+    };
+    _quadVertices.insert(_quadVertices.end(), corners, corners + 8);
+    for (int i = 0; i < 4; ++i) {
+        _quadColors.insert(_quadColors.end(), {color.r, color.g, color.b, color.a});
+    }
+}
+
+void OpenGLGraphics::flushQuads() {
+    if (_quadVertices.empty()) {
+        return;
+    }
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+    glVertexPointer(2, GL_FLOAT, 0, _quadVertices.data());
+    glColorPointer(4, GL_FLOAT, 0, _quadColors.data());
+    glDrawArrays(GL_QUADS, 0, static_cast<GLsizei>(_quadVertices.size() / 2));
+    glDisableClientState(GL_COLOR_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+    _quadVertices.clear();
+    _quadColors.clear();
+}
+
+void OpenGLGraphics::flushText() {
+    if (_textVertices.empty()) {
+        return;
+    }
+    const GLsizei stride = 4 * sizeof(float);
+    glEnable(GL_TEXTURE_2D);
+    glBindTexture(GL_TEXTURE_2D, _glyphAtlas);
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+    glVertexPointer(2, GL_FLOAT, stride, _textVertices.data());
+    glTexCoordPointer(2, GL_FLOAT, stride, _textVertices.data() + 2);
+    glColorPointer(4, GL_FLOAT, 0, _textColors.data());
+    glDrawArrays(GL_QUADS, 0, static_cast<GLsizei>(_textVertices.size() / 4));
+    glDisableClientState(GL_COLOR_ARRAY);
+    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glDisable(GL_TEXTURE_2D);
+    _textVertices.clear();
+    _textColors.clear();
+}
+
+void OpenGLGraphics::flushBatches() {
+    // At most one of the two holds anything, see drawRectangle/renderChar
+    flushQuads();
+    flushText();
+}
+
+void OpenGLGraphics::updateBoardGeometry(const RenderSnapshot& snapshot, int offsetX, int offsetY, int cellSize,
+                                         bool useAlt) {
+    size_t cellCount = static_cast<size_t>(snapshot.width) * static_cast<size_t>(snapshot.height);
+    bool layoutChanged = !_boardValid || snapshot.width != _boardWidth || snapshot.height != _boardHeight ||
+                         cellSize != _boardCellSize || offsetX != _boardOffsetX || offsetY != _boardOffsetY ||
+                         useAlt != _boardAltPalette;
+
+    if (!layoutChanged && !snapshot.fullRedraw) {
+        for (uint32_t cell : snapshot.dirtyCells) {
+            if (cell < cellCount) {
+                writeBoardCell(cell, snapshot.tiles[cell]);
+            }
+        }
+        return;
+    }
+
+    if (layoutChanged) {
+        _boardWidth = snapshot.width;
+        _boardHeight = snapshot.height;
+        _boardCellSize = cellSize;
+        _boardOffsetX = offsetX;
+        _boardOffsetY = offsetY;
+        _boardAltPalette = useAlt;
+
+        // Indexed by RenderTile; empty cells are never drawn
+        const Color* colors[] = {
+            useAlt ? &ALT_COLOR_BACKGROUND : &COLOR_BACKGROUND,
+            useAlt ? &ALT_COLOR_BORDER : &COLOR_BORDER,
+            useAlt ? &ALT_COLOR_ICE_TILE : &COLOR_ICE_TILE,
+            &COLOR_FIRE_TILE,
+            useAlt ? &ALT_COLOR_FOOD : &COLOR_FOOD,
+            &COLOR_FIRE_FOOD,
+            &COLOR_FROSTY_FOOD,
+            useAlt ? &ALT_COLOR_SNAKE_HEAD : &COLOR_SNAKE_HEAD,
+            useAlt ? &ALT_COLOR_SNAKE_BODY : &COLOR_SNAKE_BODY
+        };
+        for (size_t i = 0; i < sizeof(colors) / sizeof(colors[0]); ++i) {
+            _tilePalette[i][0] = colors[i]->r;
+            _tilePalette[i][1] = colors[i]->g;
+            _tilePalette[i][2] = colors[i]->b;
+            _tilePalette[i][3] = colors[i]->a;
+        }
+    }
+
+    _boardVertices.resize(cellCount * 8);
+    _boardColors.resize(cellCount * 16);
+    for (size_t cell = 0; cell < cellCount; ++cell) {
+        writeBoardCell(cell, snapshot.tiles[cell]);
+    }
+    _boardValid = true;
+}
+
+void OpenGLGraphics::writeBoardCell(size_t cell, uint8_t tile) {
+    const uint8_t lastTile = static_cast<uint8_t>(RenderTile::TILE_SNAKE_BODY);
+    if (tile > lastTile) {
+        tile = static_cast<uint8_t>(RenderTile::TILE_EMPTY);
+    }
+    size_t boardWidth = static_cast<size_t>(_boardWidth);
+    float x = static_cast<float>(_boardOffsetX + static_cast<int>(cell % boardWidth) * _boardCellSize);
+    float y = static_cast<float>(_boardOffsetY + static_cast<int>(cell / boardWidth) * _boardCellSize);
+    float size = static_cast<float>(_boardCellSize);
+
+    switch (static_cast<RenderTile>(tile)) {
+    case RenderTile::TILE_EMPTY:
+        // Collapsed to a point: the background shows through
+        size = 0.0f;
+        break;
+    case RenderTile::TILE_FOOD:
+    case RenderTile::TILE_FIRE_FOOD:
+    case RenderTile::TILE_FROSTY_FOOD:
+        x += 2.0f;
+        y += 2.0f;
+        size -= 4.0f;
+        break;
+    default:
+        break;
+    }
+
+    float* vertex = &_boardVertices[cell * 8];
+    vertex[0] = x;        vertex[1] = y;
+    vertex[2] = x + size; vertex[3] = y;
+    vertex[4] = x + size; vertex[5] = y + size;
+    vertex[6] = x;        vertex[7] = y + size;
+
+    float* color = &_boardColors[cell * 16];
+    for (int corner = 0; corner < 4; ++corner) {
+        std::memcpy(color + corner * 4, _tilePalette[tile], sizeof(_tilePalette[tile]));
+    }
+}
+
+void OpenGLGraphics::drawBoard() {
+    if (!_boardValid || _boardVertices.empty()) {
+        return;
+    }
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+    glVertexPointer(2, GL_FLOAT, 0, _boardVertices.data());
+    glColorPointer(4, GL_FLOAT, 0, _boardColors.data());
+    glDrawArrays(GL_QUADS, 0, static_cast<GLsizei>(_boardVertices.size() / 2));
+    glDisableClientState(GL_COLOR_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
 }
 
 void OpenGLGraphics::drawText(const std::string& text, int x, int y, const Color& color, float scale) {
@@ -596,16 +727,10 @@ bool OpenGLGraphics::initializeFonts() {
     std::string selectedFontPath;
     bool faceLoaded = false;
 
-    const auto& cachedPath = graphics::font_cache::get();
-    if (cachedPath && isUsableFontFile(*cachedPath) && tryLoadFont(*cachedPath)) {
-        selectedFontPath = *cachedPath;
+    auto resolved = graphics::font_cache::resolve("opengl", preferredFonts(), tryLoadFont);
+    if (resolved) {
+        selectedFontPath = *resolved;
         faceLoaded = true;
-    } else {
-        auto resolved = resolveFontPath(tryLoadFont);
-        if (resolved) {
-            selectedFontPath = *resolved;
-            faceLoaded = true;
-        }
     }
 
     if (!faceLoaded) {
@@ -616,7 +741,7 @@ bool OpenGLGraphics::initializeFonts() {
         return false;
     }
 
-    if (!buildGlyphCache()) {
+    if (!buildGlyphCache(selectedFontPath)) {
         std::cerr << "[OpenGLGraphics] Failed building glyph cache" << std::endl;
         shutdownFonts();
         graphics::font_cache::reset();
@@ -647,8 +772,33 @@ bool OpenGLGraphics::loadFontFace(const std::string& path) {
     return true;
 }
 
-bool OpenGLGraphics::buildGlyphCache() {
-    glPixelStorei(GL_UNPACK_ALIGNMENT, 1); // Disable byte-alignment restriction
+bool OpenGLGraphics::buildGlyphCache(const std::string& fontPath) {
+    // A warm cache skips FreeType rasterisation; the face stays loaded for
+    // kerning and line metrics either way
+    GlyphAtlasImage atlas;
+    std::string key = glyphCacheKey(fontPath, _fontPixelSize);
+    std::string cachePath = glyphCachePath(fontPath, _fontPixelSize);
+    if (key.empty() || !loadGlyphAtlasFile(cachePath, key, atlas)) {
+        atlas = GlyphAtlasImage();
+        if (!rasterizeGlyphAtlas(atlas)) {
+            return false;
+        }
+        if (!key.empty()) {
+            saveGlyphAtlasFile(cachePath, key, atlas);
+        }
+    }
+    uploadGlyphAtlas(atlas);
+    return !_glyphs.empty();
+}
+
+bool OpenGLGraphics::rasterizeGlyphAtlas(GlyphAtlasImage& atlas) {
+    // Shelf-pack every glyph into one alpha atlas, with a blank pixel
+    // between neighbours so linear filtering does not bleed across them
+    const int padding = 1;
+    atlas.width = GLYPH_ATLAS_WIDTH;
+    int penX = padding;
+    int penY = padding;
+    int rowHeight = 0;
 
     for (unsigned char c = 32; c < 127; ++c) { // Basic printable ASCII
         if (FT_Load_Char(_ftFace, c, FT_LOAD_RENDER)) {
@@ -657,50 +807,179 @@ bool OpenGLGraphics::buildGlyphCache() {
         }
 
         FT_GlyphSlot g = _ftFace->glyph;
+        int width = static_cast<int>(g->bitmap.width);
+        int height = static_cast<int>(g->bitmap.rows);
+        if (width > atlas.width - 2 * padding) {
+            std::cerr << "[OpenGLGraphics] Glyph '" << c << "' does not fit the atlas" << std::endl;
+            continue;
+        }
+        if (penX + width + padding > atlas.width) {
+            penX = padding;
+            penY += rowHeight + padding;
+            rowHeight = 0;
+        }
+
+        size_t needed = static_cast<size_t>(penY + height + padding) * atlas.width;
+        if (atlas.pixels.size() < needed) {
+            atlas.pixels.resize(needed, 0);
+        }
+        int pitch = g->bitmap.pitch;
+        for (int row = 0; row < height; ++row) {
+            // A negative pitch means the bitmap is stored bottom-up
+            const unsigned char* src = g->bitmap.buffer + (pitch >= 0 ? row : height - 1 - row) * std::abs(pitch);
+            std::memcpy(&atlas.pixels[static_cast<size_t>(penY + row) * atlas.width + penX], src, width);
+        }
+
+        PackedGlyph packed;
+        packed.c = static_cast<char>(c);
+        packed.x = penX;
+        packed.y = penY;
+        packed.metrics.u0 = packed.metrics.v0 = packed.metrics.u1 = packed.metrics.v1 = 0.0f;
+        packed.metrics.width = width;
+        packed.metrics.height = height;
+        packed.metrics.bearingX = g->bitmap_left;
+        packed.metrics.bearingY = g->bitmap_top;
+        packed.metrics.advance = g->advance.x; // 1/64 pixels
+        packed.metrics.index = g->glyph_index;
+        atlas.glyphs.push_back(packed);
+
+        penX += width + padding;
+        rowHeight = std::max(rowHeight, height);
+    }
 
-        unsigned int tex;
-        glGenTextures(1, &tex);
-        glBindTexture(GL_TEXTURE_2D, tex);
-        glTexImage2D(
-            GL_TEXTURE_2D,
-            0,
-            GL_ALPHA,
-            g->bitmap.width,
-            g->bitmap.rows,
-            0,
-            GL_ALPHA,
-            GL_UNSIGNED_BYTE,
-            g->bitmap.buffer
-        );
-
-        // Texture parameters
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-        Glyph glyph;
-        glyph.textureId = tex;
-        glyph.width = g->bitmap.width;
-        glyph.height = g->bitmap.rows;
-        glyph.bearingX = g->bitmap_left;
-        glyph.bearingY = g->bitmap_top;
-        glyph.advance = g->advance.x; // 1/64 pixels
-        glyph.index = g->glyph_index;
-
-        _glyphs[static_cast<char>(c)] = glyph;
+    if (atlas.glyphs.empty()) {
+        return false;
     }
 
+    atlas.height = 1;
+    while (atlas.height < penY + rowHeight + padding) {
+        atlas.height *= 2;
+    }
+    atlas.pixels.resize(static_cast<size_t>(atlas.height) * atlas.width, 0);
+    return true;
+}
+
+void OpenGLGraphics::uploadGlyphAtlas(const GlyphAtlasImage& atlas) {
+    for (const PackedGlyph& packed : atlas.glyphs) {
+        Glyph glyph = packed.metrics;
+        glyph.u0 = static_cast<float>(packed.x) / atlas.width;
+        glyph.v0 = static_cast<float>(packed.y) / atlas.height;
+        glyph.u1 = static_cast<float>(packed.x + glyph.width) / atlas.width;
+        glyph.v1 = static_cast<float>(packed.y + glyph.height) / atlas.height;
+        _glyphs[packed.c] = glyph;
+    }
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1); // Disable byte-alignment restriction
+    glGenTextures(1, &_glyphAtlas);
+    glBindTexture(GL_TEXTURE_2D, _glyphAtlas);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_ALPHA, atlas.width, atlas.height, 0, GL_ALPHA, GL_UNSIGNED_BYTE,
+                 atlas.pixels.data());
+
+    // Texture parameters
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
     glBindTexture(GL_TEXTURE_2D, 0);
-    return !_glyphs.empty();
+}
+
+// Native-endian binary: magic, key, atlas size, glyph records, pixels.
+// Only ever read back on the machine that wrote it.
+bool OpenGLGraphics::loadGlyphAtlasFile(const std::string& cachePath, const std::string& key,
+                                        GlyphAtlasImage& atlas) {
+    std::ifstream in(cachePath, std::ios::binary);
+    if (!in) {
+        return false;
+    }
+    char magic[sizeof(GLYPH_CACHE_MAGIC)] = {};
+    uint32_t keyLength = 0;
+    if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, GLYPH_CACHE_MAGIC, sizeof(magic)) != 0 ||
+        !readPod(in, keyLength) || keyLength != key.size()) {
+        return false;
+    }
+    std::string storedKey(keyLength, '\0');
+    uint32_t glyphCount = 0;
+    if (!in.read(&storedKey[0], keyLength) || storedKey != key || !readPod(in, atlas.width) ||
+        !readPod(in, atlas.height) || !readPod(in, glyphCount)) {
+        return false;
+    }
+    if (atlas.width != GLYPH_ATLAS_WIDTH || atlas.height <= 0 || atlas.height > 4096 || glyphCount == 0 ||
+        glyphCount > 95) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < glyphCount; ++i) {
+        PackedGlyph packed;
+        int64_t advance = 0;
+        uint32_t index = 0;
+        packed.metrics.u0 = packed.metrics.v0 = packed.metrics.u1 = packed.metrics.v1 = 0.0f;
+        if (!readPod(in, packed.c) || !readPod(in, packed.x) || !readPod(in, packed.y) ||
+            !readPod(in, packed.metrics.width) || !readPod(in, packed.metrics.height) ||
+            !readPod(in, packed.metrics.bearingX) || !readPod(in, packed.metrics.bearingY) ||
+            !readPod(in, advance) || !readPod(in, index)) {
+            return false;
+        }
+        if (packed.x < 0 || packed.y < 0 || packed.metrics.width < 0 || packed.metrics.height < 0 ||
+            packed.x + packed.metrics.width > atlas.width || packed.y + packed.metrics.height > atlas.height) {
+            return false;
+        }
+        packed.metrics.advance = static_cast<long>(advance);
+        packed.metrics.index = index;
+        atlas.glyphs.push_back(packed);
+    }
+
+    atlas.pixels.resize(static_cast<size_t>(atlas.width) * atlas.height);
+    if (!in.read(reinterpret_cast<char*>(atlas.pixels.data()), static_cast<std::streamsize>(atlas.pixels.size()))) {
+        return false;
+    }
+    return in.peek() == std::char_traits<char>::eof();
+}
+
+void OpenGLGraphics::saveGlyphAtlasFile(const std::string& cachePath, const std::string& key,
+                                        const GlyphAtlasImage& atlas) {
+    std::error_code ec;
+    fs::create_directories(fs::path(cachePath).parent_path(), ec);
+    std::string temporary = cachePath + ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            return;
+        }
+        out.write(GLYPH_CACHE_MAGIC, sizeof(GLYPH_CACHE_MAGIC));
+        writePod(out, static_cast<uint32_t>(key.size()));
+        out.write(key.data(), static_cast<std::streamsize>(key.size()));
+        writePod(out, atlas.width);
+        writePod(out, atlas.height);
+        writePod(out, static_cast<uint32_t>(atlas.glyphs.size()));
+        for (const PackedGlyph& packed : atlas.glyphs) {
+            writePod(out, packed.c);
+            writePod(out, packed.x);
+            writePod(out, packed.y);
+            writePod(out, packed.metrics.width);
+            writePod(out, packed.metrics.height);
+            writePod(out, packed.metrics.bearingX);
+            writePod(out, packed.metrics.bearingY);
+            writePod(out, static_cast<int64_t>(packed.metrics.advance));
+            writePod(out, static_cast<uint32_t>(packed.metrics.index));
+        }
+        out.write(reinterpret_cast<const char*>(atlas.pixels.data()), static_cast<std::streamsize>(atlas.pixels.size()));
+        if (!out) {
+            out.close();
+            fs::remove(temporary, ec);
+            return;
+        }
+    }
+    fs::rename(temporary, cachePath, ec);
+    if (ec) {
+        fs::remove(temporary, ec);
+    }
 }
 
 void OpenGLGraphics::shutdownFonts() {
     if (!_fontInitialized && !_ftLibrary) return;
 
-    for (auto &kv : _glyphs) {
-        safeDeleteTexture(kv.second.textureId);
-    }
+    safeDeleteTexture(_glyphAtlas);
     _glyphs.clear();
 
     if (_ftFace) {
@@ -724,20 +1003,22 @@ void OpenGLGraphics::renderChar(char c, float x, float y, float scale, const Col
     float ypos = std::round(y - g.bearingY * scale);
     float w = g.width * scale;
     float h = g.height * scale;
+    if (g.width == 0 || g.height == 0) {
+        return; // Spaces only advance the cursor
+    }
 
-    glEnable(GL_TEXTURE_2D);
-    glBindTexture(GL_TEXTURE_2D, g.textureId);
-    glColor4f(color.r, color.g, color.b, color.a);
-
-    glBegin(GL_QUADS);
-    glTexCoord2f(0.0f, 0.0f); glVertex2f(xpos,     ypos);
-    glTexCoord2f(1.0f, 0.0f); glVertex2f(xpos + w, ypos);
-    glTexCoord2f(1.0f, 1.0f); glVertex2f(xpos + w, ypos + h);
-    glTexCoord2f(0.0f, 1.0f); glVertex2f(xpos,     ypos + h);
-    glEnd();
-
-    glBindTexture(GL_TEXTURE_2D, 0);
-    glDisable(GL_TEXTURE_2D);
+    // Rectangles queued earlier have to land underneath this glyph
+    flushQuads();
+    const float vertices[16] = {
+        xpos,     ypos,     g.u0, g.v0,
+        xpos + w, ypos,     g.u1, g.v0,
+        xpos + w, ypos + h, g.u1, g.v1,
+        xpos,     ypos + h, g.u0, g.v1
+    };
+    _textVertices.insert(_textVertices.end(), vertices, vertices + 16);
+    for (int i = 0; i < 4; ++i) {
+        _textColors.insert(_textColors.end(), {color.r, color.g, color.b, color.a});
+    }
 }
 
 void OpenGLGraphics::renderText(const std::string& text, float x, float y, float scale, const Color& color) {
@@ -908,8 +1189,7 @@ void OpenGLGraphics::keyCallback(GLFWwindow* window, int key, int scancode, int
         // Allow library switching while in menu
         if (gameKey == GameKey::KEY_1 || gameKey == GameKey::KEY_2 ||
             gameKey == GameKey::KEY_3 || gameKey == GameKey::KEY_4) {
-            graphics->_lastKeyPressed = gameKey;
-            graphics->_keyConsumed = false;
+            graphics->queueKey(gameKey);
             return;
         }
 
@@ -938,12 +1218,18 @@ void OpenGLGraphics::keyCallback(GLFWwindow* window, int key, int scancode, int
 
     // Not in menu: queue the key for main loop
     if (gameKey != GameKey::NONE) {
-        graphics->_lastKeyPressed = gameKey;
-        graphics->_keyConsumed = false;
+        graphics->queueKey(gameKey);
     }
 }
 
 // C-style functions for dynamic loading
+// Board limit follows calculateGameArea: 8 px cells inside the margins
+const GraphicsCapabilities OpenGLGraphics::CAPABILITIES = {
+    GRAPHICS_ABI_VERSION, sizeof(GraphicsCapabilities),
+    GRAPHICS_CAP_SNAPSHOT_RENDER | GRAPHICS_CAP_INCREMENTAL_RENDER | GRAPHICS_CAP_VSYNC_CONTROL,
+    (WINDOW_WIDTH - 40) / 8, (WINDOW_HEIGHT - 100) / 8, 0
+};
+
 extern "C" {
     IGraphicsLibrary* createGraphicsLibrary() {
         return new OpenGLGraphics();
@@ -960,4 +1246,8 @@ extern "C" {
     const char* getLibraryVersion() {
         return "1.0.0";
     }
+
+    const GraphicsCapabilities* getGraphicsCapabilities() {
+        return &OpenGLGraphics::CAPABILITIES;
+    }
 }
@@ -4,9 +4,30 @@
 #include <raylib.h>
 #include <algorithm>
 #include <string>
-#include <chrono>
-#include <thread>
 
+namespace {
+
+const uint8_t TILE_COUNT = static_cast<uint8_t>(RenderTile::TILE_SNAKE_BODY) + 1;
+
+bool isDynamicTile(uint8_t tile) {
+    return tile >= static_cast<uint8_t>(RenderTile::TILE_FOOD) && tile < TILE_COUNT;
+}
+
+// Terrain cells relative to originX/originY; raylib batches the rectangles
+// into as few draw calls as the texture and shader allow
+void drawTerrainCells(const std::vector<uint8_t>& terrain, int boardWidth, int originX, int originY, int cellSize,
+                      const ::Color* palette) {
+    for (size_t cell = 0; cell < terrain.size(); ++cell) {
+        uint8_t tile = terrain[cell];
+        if (tile == static_cast<uint8_t>(RenderTile::TILE_EMPTY) || tile >= TILE_COUNT)
+            continue;
+        int x = static_cast<int>(cell % static_cast<size_t>(boardWidth));
+        int y = static_cast<int>(cell / static_cast<size_t>(boardWidth));
+        DrawRectangle(originX + x * cellSize, originY + y * cellSize, cellSize, cellSize, palette[tile]);
+    }
+}
+
+} // namespace
 const RaylibGraphics::Color RaylibGraphics::COLOR_BACKGROUND(20, 20, 30, 255);
 const RaylibGraphics::Color RaylibGraphics::COLOR_BORDER(100, 100, 120, 255);
 const RaylibGraphics::Color RaylibGraphics::COLOR_SNAKE_HEAD(50, 200, 50, 255);
@@ -30,7 +51,9 @@ const RaylibGraphics::Color RaylibGraphics::ALT_COLOR_ICE_TILE(110, 175, 225, 25
 const RaylibGraphics::Color RaylibGraphics::ALT_COLOR_TEXT(240, 240, 240, 255);
 
 RaylibGraphics::RaylibGraphics()
-    : _initialized(false), _shouldContinue(true), _targetFPS(60), _menuSystem(nullptr), _switchMessageTimer(0) {}
+    : _initialized(false), _shouldContinue(true), _targetFPS(60), _menuSystem(nullptr), _switchMessageTimer(0),
+      _terrainTarget(nullptr), _terrainDirty(true), _terrainAltPalette(false), _terrainCellSize(0), _boardValid(false),
+      _boardWidth(0), _boardHeight(0) {}
 
 RaylibGraphics::~RaylibGraphics() {
     shutdown();
@@ -41,22 +64,12 @@ int RaylibGraphics::initialize() {
         return 0;
     clearError();
 
-    // Extended delay to ensure previous graphics context (especially SFML) is fully released
-    std::this_thread::sleep_for(std::chrono::milliseconds(200));
-
-    // Force a complete yield to let the system process any pending graphics cleanup
-    std::this_thread::yield();
-
-    // Additional delay specifically for OpenGL context cleanup
-    std::this_thread::sleep_for(std::chrono::milliseconds(100));
-
     // Try to initialize Raylib window with error handling
     try {
+        // InitWindow returns with the context created; IsWindowReady is
+        // the readiness check, no settle time is needed
         InitWindow(WINDOW_WIDTH, WINDOW_HEIGHT, "Nibbler - Raylib");
 
-        // Give Raylib time to fully initialize its OpenGL context
-        std::this_thread::sleep_for(std::chrono::milliseconds(50));
-
         if (!IsWindowReady()) {
             setError("Failed to create Raylib window - OpenGL context conflict or graphics driver issue");
             return 1;
@@ -86,13 +99,36 @@ void RaylibGraphics::shutdown() {
     if (!_initialized)
         return;
     _shouldContinue = false;
+    // The render texture belongs to the window's GL context
+    unloadTerrain();
+    _boardValid = false;
     if (IsWindowReady())
         CloseWindow();
     _initialized = false;
     clearError();
 }
 
+bool RaylibGraphics::suspend() {
+    if (!_initialized || !IsWindowReady())
+        return false;
+    SetWindowState(FLAG_WINDOW_HIDDEN);
+    return true;
+}
+
+int RaylibGraphics::resume() {
+    if (!_initialized || !IsWindowReady())
+        return 1;
+    ClearWindowState(FLAG_WINDOW_HIDDEN);
+    _shouldContinue = true;
+    return 0;
+}
+
 void RaylibGraphics::render(const game_data& game) {
+    game.build_render_snapshot(_compatSnapshot);
+    render(_compatSnapshot);
+}
+
+void RaylibGraphics::render(const RenderSnapshot& snapshot) {
     if (!_initialized || !IsWindowReady())
         return;
 
@@ -105,18 +141,35 @@ void RaylibGraphics::render(const game_data& game) {
     const Color& ice = useAlt ? ALT_COLOR_ICE_TILE : COLOR_ICE_TILE;
     const Color& text = useAlt ? ALT_COLOR_TEXT : COLOR_TEXT;
 
-    BeginDrawing();
-    ClearBackground({bg.r, bg.g, bg.b, bg.a});
+    // One raylib colour per RenderTile, converted once per frame
+    const Color* tileColors[TILE_COUNT] = {&bg, &border, &ice, &COLOR_FIRE_TILE, &food, &COLOR_FIRE_FOOD,
+                                           &COLOR_FROSTY_FOOD, &head, &body};
+    ::Color palette[TILE_COUNT];
+    for (uint8_t i = 0; i < TILE_COUNT; ++i)
+        palette[i] = {tileColors[i]->r, tileColors[i]->g, tileColors[i]->b, tileColors[i]->a};
 
     bool menuActive = _menuSystem && _menuSystem->getCurrentState() != MenuState::IN_GAME;
+    int offsetX = 0, offsetY = 0, cellSize = 0;
     if (menuActive) {
-        renderMenu(game);
+        // Menu frames skip the dirty lists; start over when the game returns
+        _boardValid = false;
     } else {
-        int offsetX, offsetY, cellSize;
-        calculateGameArea(game, offsetX, offsetY, cellSize);
+        calculateGameArea(snapshot, offsetX, offsetY, cellSize);
+        updateBoard(snapshot);
+        // Texture mode has to be entered outside BeginDrawing
+        if (_terrainDirty || cellSize != _terrainCellSize || useAlt != _terrainAltPalette)
+            rebuildTerrain(cellSize, useAlt, palette);
+    }
+
+    BeginDrawing();
+    ClearBackground({bg.r, bg.g, bg.b, bg.a});
 
-        size_t width = game.get_width();
-        size_t height = game.get_height();
+    if (menuActive) {
+        if (snapshot.source)
+            renderMenu(*snapshot.source);
+    } else {
+        int width = snapshot.width;
+        int height = snapshot.height;
 
         // Border (toggleable)
         bool showBorders = _menuSystem && _menuSystem->getSettings().showBorders;
@@ -124,35 +177,24 @@ void RaylibGraphics::render(const game_data& game) {
             DrawRectangleLinesEx({(float)offsetX - 2, (float)offsetY - 2, (float)width * cellSize + 4, (float)height * cellSize + 4}, 2, {border.r, border.g, border.b, border.a});
         }
 
-        for (size_t y = 0; y < height; ++y) {
-            for (size_t x = 0; x < width; ++x) {
-                int px = offsetX + (int)x * cellSize;
-                int py = offsetY + (int)y * cellSize;
-                int l2 = game.get_map_value((int)x, (int)y, 2);
-                if (l2 == FOOD) {
-                    DrawRectangle(px, py, cellSize, cellSize, {food.r, food.g, food.b, food.a});
-                } else if (l2 == FIRE_FOOD) {
-                    DrawRectangle(px, py, cellSize, cellSize, {COLOR_FIRE_FOOD.r, COLOR_FIRE_FOOD.g, COLOR_FIRE_FOOD.b, COLOR_FIRE_FOOD.a});
-                } else if (l2 == FROSTY_FOOD) {
-                    DrawRectangle(px, py, cellSize, cellSize, {COLOR_FROSTY_FOOD.r, COLOR_FROSTY_FOOD.g, COLOR_FROSTY_FOOD.b, COLOR_FROSTY_FOOD.a});
-                } else if (l2 >= SNAKE_HEAD_PLAYER_1) {
-                    bool headTile = (l2 % 1000000 == 1);
-                    auto c = headTile ? head : body;
-                    DrawRectangle(px, py, cellSize, cellSize, {c.r, c.g, c.b, c.a});
-                } else {
-                    int l0 = game.get_map_value((int)x, (int)y, 0);
-                    if (l0 == GAME_TILE_WALL)
-                        DrawRectangle(px, py, cellSize, cellSize, {border.r, border.g, border.b, border.a});
-                    else if (l0 == GAME_TILE_ICE)
-                        DrawRectangle(px, py, cellSize, cellSize, {ice.r, ice.g, ice.b, ice.a});
-                    else if (l0 == GAME_TILE_FIRE)
-                        DrawRectangle(px, py, cellSize, cellSize, {COLOR_FIRE_TILE.r, COLOR_FIRE_TILE.g, COLOR_FIRE_TILE.b, COLOR_FIRE_TILE.a});
-                }
-            }
+        if (_terrainTarget) {
+            // Render textures are stored bottom-up, hence the negative height
+            Rectangle source = {0.0f, 0.0f, (float)(width * cellSize), (float)-(height * cellSize)};
+            DrawTextureRec(_terrainTarget->texture, source, {(float)offsetX, (float)offsetY}, {255, 255, 255, 255});
+        } else {
+            drawTerrainCells(_terrainTiles, width, offsetX, offsetY, cellSize, palette);
+        }
+
+        // Snake and food share the default texture and shader, so raylib
+        // sends them in one batch
+        for (uint32_t cell : _dynamicCells) {
+            int px = offsetX + static_cast<int>(cell % static_cast<uint32_t>(width)) * cellSize;
+            int py = offsetY + static_cast<int>(cell / static_cast<uint32_t>(width)) * cellSize;
+            DrawRectangle(px, py, cellSize, cellSize, palette[_boardTiles[cell]]);
         }
 
         // HUD: score/length top-left and optional FPS
-        DrawText(TextFormat("Length: %d", game.get_snake_length(0)), 10, 10, 20, {text.r, text.g, text.b, text.a});
+        DrawText(TextFormat("Length: %d", snapshot.snakeLength[0]), 10, 10, 20, {text.r, text.g, text.b, text.a});
         if (_menuSystem && _menuSystem->getSettings().showFPS) {
             DrawText(TextFormat("FPS: %d", _targetFPS), 10, 34, 16, {text.r, text.g, text.b, text.a});
         }
@@ -177,6 +219,87 @@ void RaylibGraphics::render(const game_data& game) {
     EndDrawing();
 }
 
+void RaylibGraphics::updateBoard(const RenderSnapshot& snapshot) {
+    size_t cellCount = static_cast<size_t>(snapshot.width) * static_cast<size_t>(snapshot.height);
+    bool resized = !_boardValid || snapshot.width != _boardWidth || snapshot.height != _boardHeight;
+    if (resized) {
+        _boardWidth = snapshot.width;
+        _boardHeight = snapshot.height;
+        _boardTiles.assign(cellCount, static_cast<uint8_t>(RenderTile::TILE_EMPTY));
+        _terrainTiles.assign(cellCount, static_cast<uint8_t>(RenderTile::TILE_EMPTY));
+        _dynamicCells.clear();
+        _dynamicSlot.assign(cellCount, -1);
+        _terrainDirty = true;
+    }
+
+    if (resized || snapshot.fullRedraw) {
+        for (size_t cell = 0; cell < cellCount; ++cell)
+            setBoardCell(static_cast<uint32_t>(cell), snapshot.tiles[cell]);
+    } else {
+        for (uint32_t cell : snapshot.dirtyCells) {
+            if (cell < cellCount)
+                setBoardCell(cell, snapshot.tiles[cell]);
+        }
+    }
+    _boardValid = true;
+}
+
+void RaylibGraphics::setBoardCell(uint32_t cell, uint8_t tile) {
+    if (tile >= TILE_COUNT)
+        tile = static_cast<uint8_t>(RenderTile::TILE_EMPTY);
+    _boardTiles[cell] = tile;
+
+    bool dynamic = isDynamicTile(tile);
+    if (!dynamic && _terrainTiles[cell] != tile) {
+        _terrainTiles[cell] = tile;
+        _terrainDirty = true;
+    }
+
+    int32_t slot = _dynamicSlot[cell];
+    if (dynamic && slot < 0) {
+        _dynamicSlot[cell] = static_cast<int32_t>(_dynamicCells.size());
+        _dynamicCells.push_back(cell);
+    } else if (!dynamic && slot >= 0) {
+        // Swap-remove: move the last dynamic cell into the freed slot
+        uint32_t last = _dynamicCells.back();
+        _dynamicCells[static_cast<size_t>(slot)] = last;
+        _dynamicSlot[last] = slot;
+        _dynamicCells.pop_back();
+        _dynamicSlot[cell] = -1;
+    }
+}
+
+void RaylibGraphics::rebuildTerrain(int cellSize, bool useAlt, const ::Color* palette) {
+    _terrainDirty = false;
+    _terrainCellSize = cellSize;
+    _terrainAltPalette = useAlt;
+
+    int width = _boardWidth * cellSize;
+    int height = _boardHeight * cellSize;
+    if (_terrainTarget && (_terrainTarget->texture.width != width || _terrainTarget->texture.height != height))
+        unloadTerrain();
+    if (!_terrainTarget) {
+        RenderTexture2D target = LoadRenderTexture(width, height);
+        if (target.id == 0)
+            return; // Terrain is drawn cell by cell instead
+        _terrainTarget = new RenderTexture2D(target);
+    }
+
+    BeginTextureMode(*_terrainTarget);
+    ClearBackground(palette[static_cast<uint8_t>(RenderTile::TILE_EMPTY)]);
+    drawTerrainCells(_terrainTiles, _boardWidth, 0, 0, cellSize, palette);
+    EndTextureMode();
+}
+
+void RaylibGraphics::unloadTerrain() {
+    if (_terrainTarget) {
+        UnloadRenderTexture(*_terrainTarget);
+        delete _terrainTarget;
+        _terrainTarget = nullptr;
+    }
+    _terrainDirty = true;
+}
+
 GameKey RaylibGraphics::getInput() {
     if (!_initialized || !IsWindowReady())
         return GameKey::NONE;
@@ -267,9 +390,9 @@ void RaylibGraphics::clearError() {
     _errorMessage.clear();
 }
 
-void RaylibGraphics::calculateGameArea(const game_data& game, int& offsetX, int& offsetY, int& cellSize) {
-    size_t gw = game.get_width();
-    size_t gh = game.get_height();
+void RaylibGraphics::calculateGameArea(const RenderSnapshot& snapshot, int& offsetX, int& offsetY, int& cellSize) {
+    size_t gw = static_cast<size_t>(snapshot.width);
+    size_t gh = static_cast<size_t>(snapshot.height);
     int maxCellW = (WINDOW_WIDTH - 40) / (int)gw;
     int maxCellH = (WINDOW_HEIGHT - 100) / (int)gh;
     cellSize = std::max(8, std::min(maxCellW, maxCellH));
@@ -506,6 +629,14 @@ void RaylibGraphics::drawMenuItems(const std::vector<MenuItem>& items, int selec
     }
 }
 
+// Board limit follows calculateGameArea: 8 px cells inside the margins.
+// Frame pacing is left to SetTargetFPS, so no vsync control.
+const GraphicsCapabilities RaylibGraphics::CAPABILITIES = {
+    GRAPHICS_ABI_VERSION, sizeof(GraphicsCapabilities),
+    GRAPHICS_CAP_SNAPSHOT_RENDER | GRAPHICS_CAP_INCREMENTAL_RENDER,
+    (WINDOW_WIDTH - 40) / 8, (WINDOW_HEIGHT - 100) / 8, 0
+};
+
 extern "C" {
 IGraphicsLibrary* createGraphicsLibrary() {
     return new RaylibGraphics();
@@ -519,4 +650,7 @@ const char* getLibraryName() {
 const char* getLibraryVersion() {
     return "1.0.0";
 }
+const GraphicsCapabilities* getGraphicsCapabilities() {
+    return &RaylibGraphics::CAPABILITIES;
+}
 }
@@ -6,24 +6,12 @@
 #include <sstream>
 #include <algorithm>
 #include <cstring>
-#include <filesystem>
 #include <vector>
-#include <unordered_set>
-#include <optional>
-#include <cstdlib>
-#include <cctype>
 
 namespace {
-namespace fs = std::filesystem;
-
-bool isUsableFontFile(const fs::path& path) {
-    std::error_code ec;
-    return fs::exists(path, ec) && fs::is_regular_file(path, ec);
-}
-
-template <typename TryLoad>
-std::optional<std::string> resolveFontPath(TryLoad&& tryLoad) {
-    static const std::vector<std::string> priorityFonts = {
+// Tried first; font_cache finds the rest through its index
+const std::vector<std::string>& preferredFonts() {
+    static const std::vector<std::string> fonts = {
         // macOS - Arial fonts
         "/System/Library/Fonts/Supplemental/Arial.ttf",
         "/System/Library/Fonts/Supplemental/Arial Unicode.ttf",
@@ -55,121 +43,7 @@ std::optional<std::string> resolveFontPath(TryLoad&& tryLoad) {
         "/usr/share/fonts/google-noto/NotoSansUI-Regular.ttf",
         "/usr/local/share/fonts/DejaVuSans.ttf"
     };
-
-    static const std::vector<std::string> fontDirectories = {
-        "/usr/share/fonts",
-        "/usr/local/share/fonts",
-        "/usr/share/fonts/truetype",
-        "/usr/share/fonts/TTF",
-        "/usr/share/fonts/opentype",
-        "/usr/share/fonts/dejavu",
-        "/usr/share/fonts/liberation",
-        "/usr/share/fonts/google-noto",
-        "/usr/share/fonts/gnu-free",
-        "/usr/share/fonts/freefont",
-        "/usr/share/fonts/cantarell",
-        "/usr/share/fonts/roboto",
-        "/usr/share/fonts/adobe-source-sans-pro",
-        "/usr/share/fonts/adobe-source-code-pro",
-        "/usr/share/fonts/abattis-cantarell",
-        "/usr/share/fonts/fedora",
-        "/usr/share/fonts/dejavu-serif",
-        "/usr/share/fonts/OfL",
-        "/usr/share/fonts/truetype/msttcorefonts",
-        "/usr/share/fonts/truetype/droid",
-        "/usr/share/fonts/truetype/abyssinica",
-        "/usr/share/fonts/truetype/lato",
-        "/usr/share/fonts/truetype/fonts-japanese-gothic",
-        "/usr/share/fonts/truetype/source-sans-pro",
-        "/usr/share/fonts/truetype/hack",
-        "/usr/share/fonts/truetype/fira",
-        "/usr/share/fonts/truetype/cantarell"
-    };
-
-    std::unordered_set<std::string> seen;
-    seen.reserve(priorityFonts.size() * 2);
-
-    auto considerCandidate = [&](const std::string& path) -> std::optional<std::string> {
-        if (path.empty()) {
-            return std::nullopt;
-        }
-        if (!seen.insert(path).second) {
-            return std::nullopt;
-        }
-        if (!isUsableFontFile(path)) {
-            return std::nullopt;
-        }
-        if (tryLoad(path)) {
-            return path;
-        }
-        return std::nullopt;
-    };
-
-    auto searchDirectory = [&](const fs::path& dir) -> std::optional<std::string> {
-        std::error_code ec;
-        if (!fs::exists(dir, ec) || !fs::is_directory(dir, ec)) {
-            return std::nullopt;
-        }
-        try {
-            for (const auto& entry : fs::recursive_directory_iterator(dir, fs::directory_options::skip_permission_denied)) {
-                if (!entry.is_regular_file()) {
-                    continue;
-                }
-                auto ext = entry.path().extension().string();
-                std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) {
-                    return static_cast<char>(std::tolower(c));
-                });
-                if (ext == ".ttf" || ext == ".otf" || ext == ".ttc") {
-                    if (auto chosen = considerCandidate(entry.path().string())) {
-                        return chosen;
-                    }
-                }
-            }
-        } catch (const std::exception&) {
-            // Ignore directories we cannot traverse
-        }
-        return std::nullopt;
-    };
-
-    for (const auto& path : priorityFonts) {
-        if (auto chosen = considerCandidate(path)) {
-            return chosen;
-        }
-    }
-
-    const char* homeEnv = std::getenv("HOME");
-    if (homeEnv) {
-        fs::path homePath(homeEnv);
-        if (auto chosen = considerCandidate((homePath / ".fonts/DejaVuSans.ttf").string())) {
-            return chosen;
-        }
-        if (auto chosen = considerCandidate((homePath / ".fonts/Arial.ttf").string())) {
-            return chosen;
-        }
-        if (auto chosen = considerCandidate((homePath / ".local/share/fonts/DejaVuSans.ttf").string())) {
-            return chosen;
-        }
-        if (auto chosen = considerCandidate((homePath / ".local/share/fonts/Arial.ttf").string())) {
-            return chosen;
-        }
-    }
-
-    for (const auto& dir : fontDirectories) {
-        if (auto chosen = searchDirectory(dir)) {
-            return chosen;
-        }
-    }
-
-    if (homeEnv) {
-        if (auto chosen = searchDirectory(fs::path(homeEnv) / ".fonts")) {
-            return chosen;
-        }
-        if (auto chosen = searchDirectory(fs::path(homeEnv) / ".local/share/fonts")) {
-            return chosen;
-        }
-    }
-
-    return std::nullopt;
+    return fonts;
 }
 } // namespace
 
@@ -201,7 +75,8 @@ const SDL2Graphics::Color SDL2Graphics::COLOR_SELECTED_TEXT(255, 255, 255); // W
 
 SDL2Graphics::SDL2Graphics()
     : _initialized(false), _shouldContinue(true), _targetFPS(60), _frameDelay(1000 / 60),
-      _window(nullptr), _renderer(nullptr), _fontLarge(nullptr), _fontMedium(nullptr),
+      _window(nullptr), _renderer(nullptr), _terrainTexture(nullptr), _terrainDirty(true),
+      _terrainAltPalette(false), _terrainCellSize(0), _terrainWidth(0), _terrainHeight(0), _fontLarge(nullptr), _fontMedium(nullptr),
       _fontSmall(nullptr), _menuSystem(nullptr), _switchMessageTimer(0) {
 }
 
@@ -301,6 +176,8 @@ void SDL2Graphics::shutdown() {
 
     // Shutdown fonts first
     shutdownFonts();
+    destroyTerrainTexture();
+    _terrainTiles.clear();
 
     // Destroy renderer
     if (_renderer) {
@@ -327,13 +204,38 @@ void SDL2Graphics::shutdown() {
     TTF_Quit();
     SDL_Quit();
 
-    // Small delay to ensure window is fully closed
-    SDL_Delay(50);
-
     _initialized = false;
 }
 
+bool SDL2Graphics::suspend() {
+    if (!_initialized || !_window) {
+        return false;
+    }
+    // Renderer, fonts and textures stay alive; only the window goes away
+    SDL_HideWindow(_window);
+    SDL_PumpEvents();
+    SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+    return true;
+}
+
+int SDL2Graphics::resume() {
+    if (!_initialized || !_window) {
+        return 1;
+    }
+    SDL_ShowWindow(_window);
+    SDL_RaiseWindow(_window);
+    // Drop keys and window events queued while another library was active
+    SDL_PumpEvents();
+    SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+    return 0;
+}
+
 void SDL2Graphics::render(const game_data& game) {
+    game.build_render_snapshot(_compatSnapshot);
+    render(_compatSnapshot);
+}
+
+void SDL2Graphics::render(const RenderSnapshot& snapshot) {
     if (!_initialized) {
         return;
     }
@@ -341,10 +243,6 @@ void SDL2Graphics::render(const game_data& game) {
     bool useAlt = _menuSystem && _menuSystem->getSettings().useAlternativeColors;
     const Color& bg = useAlt ? ALT_COLOR_BACKGROUND : COLOR_BACKGROUND;
     const Color& border = useAlt ? ALT_COLOR_BORDER : COLOR_BORDER;
-    const Color& head = useAlt ? ALT_COLOR_SNAKE_HEAD : COLOR_SNAKE_HEAD;
-    const Color& body = useAlt ? ALT_COLOR_SNAKE_BODY : COLOR_SNAKE_BODY;
-    const Color& food = useAlt ? ALT_COLOR_FOOD : COLOR_FOOD;
-    const Color& ice = useAlt ? ALT_COLOR_ICE_TILE : COLOR_ICE_TILE;
     const Color& text = useAlt ? ALT_COLOR_TEXT : COLOR_TEXT;
 
     // Clear screen with background color
@@ -353,14 +251,15 @@ void SDL2Graphics::render(const game_data& game) {
 
     bool menuActive = _menuSystem && _menuSystem->getCurrentState() != MenuState::IN_GAME;
     if (menuActive) {
-        renderMenu(game);
+        if (snapshot.source)
+            renderMenu(*snapshot.source);
     } else {
         // Calculate game area positioning
         int offsetX, offsetY, cellSize;
-        calculateGameArea(game, offsetX, offsetY, cellSize);
+        calculateGameArea(snapshot, offsetX, offsetY, cellSize);
 
-        size_t width = game.get_width();
-        size_t height = game.get_height();
+        int width = snapshot.width;
+        int height = snapshot.height;
 
         // Draw border (toggleable)
         bool showBorders = _menuSystem && _menuSystem->getSettings().showBorders;
@@ -370,53 +269,22 @@ void SDL2Graphics::render(const game_data& game) {
         }
 
         // Draw game tiles
-        for (size_t y = 0; y < height; ++y) {
-            for (size_t x = 0; x < width; ++x) {
-                int pixelX = offsetX + x * cellSize;
-                int pixelY = offsetY + y * cellSize;
-
-                // Check layer 2 first (snake and food)
-                int layer2Value = game.get_map_value(static_cast<int>(x), static_cast<int>(y), 2);
-                if (layer2Value == FOOD) {
-                    setDrawColor(food);
-                    drawRect(pixelX + 2, pixelY + 2, cellSize - 4, cellSize - 4);
-                } else if (layer2Value == FIRE_FOOD) {
-                    setDrawColor(COLOR_FIRE_FOOD);
-                    drawRect(pixelX + 2, pixelY + 2, cellSize - 4, cellSize - 4);
-                } else if (layer2Value == FROSTY_FOOD) {
-                    setDrawColor(COLOR_FROSTY_FOOD);
-                    drawRect(pixelX + 2, pixelY + 2, cellSize - 4, cellSize - 4);
-                } else if (layer2Value >= SNAKE_HEAD_PLAYER_1) {
-                    if (layer2Value % 1000000 == 1) {
-                        setDrawColor(head);
-                    } else {
-                        setDrawColor(body);
-                    }
-                    drawRect(pixelX, pixelY, cellSize, cellSize);
-                } else {
-                    // Check layer 0 (terrain)
-                    int layer0Value = game.get_map_value(static_cast<int>(x), static_cast<int>(y), 0);
-                    if (layer0Value == GAME_TILE_WALL) {
-                        setDrawColor(border);
-                        drawRect(pixelX, pixelY, cellSize, cellSize);
-                    } else if (layer0Value == GAME_TILE_ICE) {
-                        setDrawColor(ice);
-                        drawRect(pixelX, pixelY, cellSize, cellSize);
-                    } else if (layer0Value == GAME_TILE_FIRE) {
-                        setDrawColor(COLOR_FIRE_TILE);
-                        drawRect(pixelX, pixelY, cellSize, cellSize);
-                    }
-                    // Empty space - no drawing needed
-                }
-            }
-        }
+        drawBoard(snapshot, offsetX, offsetY, cellSize, useAlt);
 
         // HUD: show snake length and optional FPS in top-left
         {
-            std::string scoreText = "Length: " + std::to_string(game.get_snake_length(0));
-            drawTextWithFont(scoreText, 10, 10, _fontMedium, text);
+            // Labels come from the text cache, numbers from the digit atlas
+            const TextTexture* label = getTextTexture("Length: ", _fontMedium, text);
+            if (label) {
+                drawTextWithFont("Length: ", 10, 10, _fontMedium, text);
+                drawNumber(snapshot.snakeLength[0], 10 + label->width, 10, _fontMedium, text);
+            }
             if (_menuSystem && _menuSystem->getSettings().showFPS) {
-                drawTextWithFont(std::string("FPS: ") + std::to_string(_targetFPS), 10, 35, _fontSmall, text);
+                label = getTextTexture("FPS: ", _fontSmall, text);
+                if (label) {
+                    drawTextWithFont("FPS: ", 10, 35, _fontSmall, text);
+                    drawNumber(_targetFPS, 10 + label->width, 35, _fontSmall, text);
+                }
             }
         }
     }
@@ -444,6 +312,14 @@ void SDL2Graphics::render(const game_data& game) {
     SDL_RenderPresent(_renderer);
 }
 
+int SDL2Graphics::waitForInput(int timeoutMs) {
+    if (!_initialized) {
+        return -1;
+    }
+    // With no event to fill in, SDL leaves the pending event queued
+    return SDL_WaitEventTimeout(nullptr, timeoutMs) ? 1 : 0;
+}
+
 GameKey SDL2Graphics::getInput() {
     if (!_initialized) {
         return GameKey::NONE;
@@ -456,6 +332,17 @@ GameKey SDL2Graphics::getInput() {
             _shouldContinue = false;
             return GameKey::QUIT;
 
+        case SDL_RENDER_TARGETS_RESET:
+            // Target texture contents are gone
+            _terrainDirty = true;
+            break;
+
+        case SDL_RENDER_DEVICE_RESET:
+            // Every texture is gone
+            _terrainDirty = true;
+            clearTextCache();
+            break;
+
         case SDL_KEYDOWN: {
             SDL_Keycode key = event.key.keysym.sym;
 
@@ -516,6 +403,16 @@ void SDL2Graphics::setFrameRate(int fps) {
     _frameDelay = (fps > 0) ? (1000 / fps) : (1000 / 60);
 }
 
+void SDL2Graphics::setVsync(bool enabled) {
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    if (_renderer) {
+        SDL_RenderSetVSync(_renderer, enabled ? 1 : 0);
+    }
+#else
+    (void)enabled;
+#endif
+}
+
 void SDL2Graphics::setMenuSystem(MenuSystem* menuSystem) {
     _menuSystem = menuSystem;
 }
@@ -557,6 +454,192 @@ void SDL2Graphics::drawTransparentRect(int x, int y, int width, int height, cons
     SDL_SetRenderDrawBlendMode(_renderer, SDL_BLENDMODE_NONE);
 }
 
+void SDL2Graphics::drawBoard(const RenderSnapshot& snapshot, int offsetX, int offsetY, int cellSize, bool useAlt) {
+    if (updateTerrain(snapshot) || cellSize != _terrainCellSize || useAlt != _terrainAltPalette) {
+        _terrainDirty = true;
+    }
+
+    for (std::vector<SDL_Rect>& batch : _boardBatches) {
+        batch.clear();
+    }
+    for (int y = 0; y < snapshot.height; ++y) {
+        for (int x = 0; x < snapshot.width; ++x) {
+            SDL_Rect cell = {x * cellSize, y * cellSize, cellSize, cellSize};
+            SDL_Rect item = {cell.x + 2, cell.y + 2, cellSize - 4, cellSize - 4};
+
+            switch (snapshot.at(x, y)) {
+            case RenderTile::TILE_FOOD:
+                _boardBatches[BATCH_FOOD_BACKING].push_back(cell);
+                _boardBatches[BATCH_FOOD].push_back(item);
+                break;
+            case RenderTile::TILE_FIRE_FOOD:
+                _boardBatches[BATCH_FOOD_BACKING].push_back(cell);
+                _boardBatches[BATCH_FIRE_FOOD].push_back(item);
+                break;
+            case RenderTile::TILE_FROSTY_FOOD:
+                _boardBatches[BATCH_FOOD_BACKING].push_back(cell);
+                _boardBatches[BATCH_FROSTY_FOOD].push_back(item);
+                break;
+            case RenderTile::TILE_SNAKE_HEAD:
+                _boardBatches[BATCH_SNAKE_HEAD].push_back(cell);
+                break;
+            case RenderTile::TILE_SNAKE_BODY:
+                _boardBatches[BATCH_SNAKE_BODY].push_back(cell);
+                break;
+            default:
+                // Terrain and empty cells come from the terrain layer
+                break;
+            }
+        }
+    }
+
+    // Switching render targets resets the viewport, so rebuild first
+    if (_terrainDirty) {
+        rebuildTerrainTexture(cellSize, useAlt);
+    }
+
+    // Board coordinates from here on
+    SDL_Rect viewport = {offsetX, offsetY, snapshot.width * cellSize, snapshot.height * cellSize};
+    SDL_RenderSetViewport(_renderer, &viewport);
+    if (_terrainTexture) {
+        SDL_Rect board = {0, 0, viewport.w, viewport.h};
+        SDL_RenderCopy(_renderer, _terrainTexture, nullptr, &board);
+    } else {
+        drawTerrain(cellSize, useAlt);
+    }
+
+    // Food used to sit on the plain background; keep it that way even when
+    // the terrain layer still remembers a tile under it
+    const Color* colors[BATCH_COUNT] = {
+        useAlt ? &ALT_COLOR_BACKGROUND : &COLOR_BACKGROUND,
+        useAlt ? &ALT_COLOR_FOOD : &COLOR_FOOD,
+        &COLOR_FIRE_FOOD,
+        &COLOR_FROSTY_FOOD,
+        useAlt ? &ALT_COLOR_SNAKE_HEAD : &COLOR_SNAKE_HEAD,
+        useAlt ? &ALT_COLOR_SNAKE_BODY : &COLOR_SNAKE_BODY
+    };
+    for (int i = 0; i < BATCH_COUNT; ++i) {
+        const std::vector<SDL_Rect>& batch = _boardBatches[i];
+        if (batch.empty()) {
+            continue;
+        }
+        setDrawColor(*colors[i]);
+        SDL_RenderFillRects(_renderer, batch.data(), static_cast<int>(batch.size()));
+    }
+
+    SDL_RenderSetViewport(_renderer, nullptr);
+}
+
+bool SDL2Graphics::updateTerrain(const RenderSnapshot& snapshot) {
+    size_t cellCount = static_cast<size_t>(snapshot.width) * static_cast<size_t>(snapshot.height);
+    bool changed = false;
+    if (snapshot.width != _terrainWidth || snapshot.height != _terrainHeight) {
+        _terrainWidth = snapshot.width;
+        _terrainHeight = snapshot.height;
+        _terrainTiles.assign(cellCount, static_cast<Uint8>(RenderTile::TILE_EMPTY));
+        changed = true;
+    }
+
+    for (size_t cell = 0; cell < cellCount; ++cell) {
+        Uint8 tile = snapshot.tiles[cell];
+        switch (static_cast<RenderTile>(tile)) {
+        case RenderTile::TILE_EMPTY:
+        case RenderTile::TILE_WALL:
+        case RenderTile::TILE_ICE:
+        case RenderTile::TILE_FIRE:
+            if (_terrainTiles[cell] != tile) {
+                _terrainTiles[cell] = tile;
+                changed = true;
+            }
+            break;
+        default:
+            break;
+        }
+    }
+    return changed;
+}
+
+void SDL2Graphics::drawTerrain(int cellSize, bool useAlt) {
+    std::vector<SDL_Rect> walls;
+    std::vector<SDL_Rect> ice;
+    std::vector<SDL_Rect> fire;
+    for (size_t cell = 0; cell < _terrainTiles.size(); ++cell) {
+        int x = static_cast<int>(cell % static_cast<size_t>(_terrainWidth));
+        int y = static_cast<int>(cell / static_cast<size_t>(_terrainWidth));
+        SDL_Rect rect = {x * cellSize, y * cellSize, cellSize, cellSize};
+        switch (static_cast<RenderTile>(_terrainTiles[cell])) {
+        case RenderTile::TILE_WALL:
+            walls.push_back(rect);
+            break;
+        case RenderTile::TILE_ICE:
+            ice.push_back(rect);
+            break;
+        case RenderTile::TILE_FIRE:
+            fire.push_back(rect);
+            break;
+        default:
+            break;
+        }
+    }
+
+    if (!walls.empty()) {
+        setDrawColor(useAlt ? ALT_COLOR_BORDER : COLOR_BORDER);
+        SDL_RenderFillRects(_renderer, walls.data(), static_cast<int>(walls.size()));
+    }
+    if (!ice.empty()) {
+        setDrawColor(useAlt ? ALT_COLOR_ICE_TILE : COLOR_ICE_TILE);
+        SDL_RenderFillRects(_renderer, ice.data(), static_cast<int>(ice.size()));
+    }
+    if (!fire.empty()) {
+        setDrawColor(COLOR_FIRE_TILE);
+        SDL_RenderFillRects(_renderer, fire.data(), static_cast<int>(fire.size()));
+    }
+}
+
+void SDL2Graphics::rebuildTerrainTexture(int cellSize, bool useAlt) {
+    _terrainDirty = false;
+    _terrainCellSize = cellSize;
+    _terrainAltPalette = useAlt;
+
+    int width = _terrainWidth * cellSize;
+    int height = _terrainHeight * cellSize;
+    int textureWidth = 0;
+    int textureHeight = 0;
+    if (_terrainTexture) {
+        SDL_QueryTexture(_terrainTexture, nullptr, nullptr, &textureWidth, &textureHeight);
+    }
+    if (_terrainTexture && (textureWidth != width || textureHeight != height)) {
+        destroyTerrainTexture();
+    }
+    if (!_terrainTexture) {
+        if (!SDL_RenderTargetSupported(_renderer)) {
+            return; // drawTerrain() every frame instead
+        }
+        _terrainTexture = SDL_CreateTexture(_renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, width,
+                                            height);
+        if (!_terrainTexture) {
+            return;
+        }
+    }
+
+    if (SDL_SetRenderTarget(_renderer, _terrainTexture) != 0) {
+        destroyTerrainTexture();
+        return;
+    }
+    setDrawColor(useAlt ? ALT_COLOR_BACKGROUND : COLOR_BACKGROUND);
+    SDL_RenderClear(_renderer);
+    drawTerrain(cellSize, useAlt);
+    SDL_SetRenderTarget(_renderer, nullptr);
+}
+
+void SDL2Graphics::destroyTerrainTexture() {
+    if (_terrainTexture) {
+        SDL_DestroyTexture(_terrainTexture);
+        _terrainTexture = nullptr;
+    }
+    _terrainDirty = true;
+}
+
 GameKey SDL2Graphics::translateSDLKey(SDL_Keycode key) {
     switch (key) {
     case SDLK_UP:
@@ -581,9 +664,9 @@ GameKey SDL2Graphics::translateSDLKey(SDL_Keycode key) {
     }
 }
 
-void SDL2Graphics::calculateGameArea(const game_data& game, int& offsetX, int& offsetY, int& cellSize) {
-    size_t gameWidth = game.get_width();
-    size_t gameHeight = game.get_height();
+void SDL2Graphics::calculateGameArea(const RenderSnapshot& snapshot, int& offsetX, int& offsetY, int& cellSize) {
+    size_t gameWidth = static_cast<size_t>(snapshot.width);
+    size_t gameHeight = static_cast<size_t>(snapshot.height);
 
     // Calculate the best cell size that fits in the window
     int maxCellWidth = (WINDOW_WIDTH - 100) / gameWidth;    // Leave 100px margin
@@ -882,14 +965,9 @@ bool SDL2Graphics::initializeFonts() {
 
     std::string selectedFontPath;
 
-    const auto& cachedPath = graphics::font_cache::get();
-    if (cachedPath && isUsableFontFile(*cachedPath) && tryLoadFont(*cachedPath)) {
-        selectedFontPath = *cachedPath;
-    } else {
-        auto resolved = resolveFontPath(tryLoadFont);
-        if (resolved) {
-            selectedFontPath = *resolved;
-        }
+    auto resolved = graphics::font_cache::resolve("sdl2", preferredFonts(), tryLoadFont);
+    if (resolved) {
+        selectedFontPath = *resolved;
     }
 
     if (selectedFontPath.empty()) {
@@ -915,6 +993,7 @@ bool SDL2Graphics::initializeFonts() {
 }
 
 void SDL2Graphics::shutdownFonts() {
+    clearTextCache();
     if (_fontLarge) {
         TTF_CloseFont(_fontLarge);
         _fontLarge = nullptr;
@@ -930,8 +1009,43 @@ void SDL2Graphics::shutdownFonts() {
 }
 
 void SDL2Graphics::drawTextWithFont(const std::string& text, int x, int y, TTF_Font* font, const Color& color) {
-    if (!font || text.empty())
+    const TextTexture* entry = getTextTexture(text, font, color);
+    if (!entry) {
+        return;
+    }
+    SDL_Rect destRect = {x, y, entry->width, entry->height};
+    SDL_RenderCopy(_renderer, entry->texture, nullptr, &destRect);
+}
+
+void SDL2Graphics::drawCenteredTextWithFont(const std::string& text, int y, TTF_Font* font, const Color& color) {
+    const TextTexture* entry = getTextTexture(text, font, color);
+    if (!entry) {
         return;
+    }
+    SDL_Rect destRect = {(WINDOW_WIDTH - entry->width) / 2, y, entry->width, entry->height};
+    SDL_RenderCopy(_renderer, entry->texture, nullptr, &destRect);
+}
+
+size_t SDL2Graphics::TextKeyHash::operator()(const TextKey& key) const {
+    size_t hash = std::hash<std::string>()(key.text);
+    hash ^= std::hash<const void*>()(key.font) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    hash ^= std::hash<Uint32>()(key.color) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    return hash;
+}
+
+const SDL2Graphics::TextTexture* SDL2Graphics::getTextTexture(const std::string& text, TTF_Font* font,
+                                                              const Color& color) {
+    if (!font || text.empty())
+        return nullptr;
+
+    TextKey key = {font, static_cast<Uint32>(color.r) << 24 | static_cast<Uint32>(color.g) << 16 |
+                             static_cast<Uint32>(color.b) << 8 | color.a,
+                   text};
+    auto found = _textCacheIndex.find(key);
+    if (found != _textCacheIndex.end()) {
+        _textCache.splice(_textCache.begin(), _textCache, found->second);
+        return &*found->second;
+    }
 
     // Clean the text string to handle problematic ASCII characters
     std::string cleanText = text;
@@ -959,7 +1073,7 @@ void SDL2Graphics::drawTextWithFont(const std::string& text, int x, int y, TTF_F
         // Fallback to solid rendering if blended fails
         textSurface = TTF_RenderText_Solid(font, cleanText.c_str(), sdlColor);
         if (!textSurface) {
-            return; // Failed to render text
+            return nullptr; // Failed to render text
         }
     }
 
@@ -967,25 +1081,91 @@ void SDL2Graphics::drawTextWithFont(const std::string& text, int x, int y, TTF_F
     SDL_FreeSurface(textSurface);
 
     if (!textTexture) {
-        return; // Failed to create texture
+        return nullptr; // Failed to create texture
     }
 
-    int textWidth, textHeight;
-    SDL_QueryTexture(textTexture, nullptr, nullptr, &textWidth, &textHeight);
+    if (_textCache.size() >= TEXT_CACHE_CAPACITY) {
+        TextTexture& oldest = _textCache.back();
+        SDL_DestroyTexture(oldest.texture);
+        _textCacheIndex.erase(oldest.key);
+        _textCache.pop_back();
+    }
+
+    TextTexture entry = {key, textTexture, 0, 0};
+    SDL_QueryTexture(textTexture, nullptr, nullptr, &entry.width, &entry.height);
+    _textCache.push_front(entry);
+    _textCacheIndex[key] = _textCache.begin();
+    return &_textCache.front();
+}
 
-    SDL_Rect destRect = {x, y, textWidth, textHeight};
-    SDL_RenderCopy(_renderer, textTexture, nullptr, &destRect);
+const SDL2Graphics::DigitAtlas* SDL2Graphics::getDigitAtlas(TTF_Font* font) {
+    if (!font)
+        return nullptr;
+    for (const DigitAtlas& atlas : _digitAtlases) {
+        if (atlas.font == font)
+            return atlas.texture ? &atlas : nullptr;
+    }
 
-    SDL_DestroyTexture(textTexture);
+    // Remembered even on failure so a broken font is not retried every frame
+    DigitAtlas atlas = {font, nullptr, {0}, 0};
+    static const char digits[] = "0123456789";
+    SDL_Color white = {255, 255, 255, 255};
+    bool measured = true;
+    for (int i = 1; i <= 10 && measured; ++i) {
+        std::string prefix(digits, static_cast<size_t>(i));
+        measured = TTF_SizeText(font, prefix.c_str(), &atlas.offsets[i], nullptr) == 0;
+    }
+    SDL_Surface* surface = measured ? TTF_RenderText_Blended(font, digits, white) : nullptr;
+    if (surface) {
+        atlas.texture = SDL_CreateTextureFromSurface(_renderer, surface);
+        atlas.height = surface->h;
+        SDL_FreeSurface(surface);
+    }
+    _digitAtlases.push_back(atlas);
+    return atlas.texture ? &_digitAtlases.back() : nullptr;
 }
 
-void SDL2Graphics::drawCenteredTextWithFont(const std::string& text, int y, TTF_Font* font, const Color& color) {
-    if (!font || text.empty())
-        return;
+int SDL2Graphics::drawNumber(int value, int x, int y, TTF_Font* font, const Color& color) {
+    const DigitAtlas* atlas = value >= 0 ? getDigitAtlas(font) : nullptr;
+    if (!atlas) {
+        // Negative numbers and fonts without an atlas go through the cache
+        std::string text = std::to_string(value);
+        drawTextWithFont(text, x, y, font, color);
+        return getTextWidth(text, font);
+    }
 
-    int textWidth = getTextWidth(text, font);
-    int x = (WINDOW_WIDTH - textWidth) / 2;
-    drawTextWithFont(text, x, y, font, color);
+    char digits[16];
+    int count = 0;
+    do {
+        digits[count++] = static_cast<char>(value % 10);
+        value /= 10;
+    } while (value > 0);
+
+    SDL_SetTextureColorMod(atlas->texture, color.r, color.g, color.b);
+    int cursor = x;
+    while (count > 0) {
+        int digit = digits[--count];
+        int width = atlas->offsets[digit + 1] - atlas->offsets[digit];
+        SDL_Rect src = {atlas->offsets[digit], 0, width, atlas->height};
+        SDL_Rect dst = {cursor, y, width, atlas->height};
+        SDL_RenderCopy(_renderer, atlas->texture, &src, &dst);
+        cursor += width;
+    }
+    return cursor - x;
+}
+
+void SDL2Graphics::clearTextCache() {
+    for (TextTexture& entry : _textCache) {
+        SDL_DestroyTexture(entry.texture);
+    }
+    _textCache.clear();
+    _textCacheIndex.clear();
+    for (DigitAtlas& atlas : _digitAtlases) {
+        if (atlas.texture) {
+            SDL_DestroyTexture(atlas.texture);
+        }
+    }
+    _digitAtlases.clear();
 }
 
 int SDL2Graphics::getTextWidth(const std::string& text, TTF_Font* font) {
@@ -1006,6 +1186,17 @@ int SDL2Graphics::getTextHeight(TTF_Font* font) {
 }
 
 // C interface for dynamic library loading
+// Board limit follows calculateGameArea: 10 px cells inside the margins
+const GraphicsCapabilities SDL2Graphics::CAPABILITIES = {
+    GRAPHICS_ABI_VERSION, sizeof(GraphicsCapabilities),
+    GRAPHICS_CAP_SNAPSHOT_RENDER
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+        | GRAPHICS_CAP_VSYNC_CONTROL
+#endif
+    ,
+    (WINDOW_WIDTH - 100) / 10, (WINDOW_HEIGHT - 150) / 10, 0
+};
+
 extern "C" {
 IGraphicsLibrary* createGraphicsLibrary() {
     return new SDL2Graphics();
@@ -1022,4 +1213,8 @@ const char* getLibraryName() {
 const char* getLibraryVersion() {
     return "1.0.0";
 }
+
+const GraphicsCapabilities* getGraphicsCapabilities() {
+    return &SDL2Graphics::CAPABILITIES;
+}
 }
@@ -20,6 +20,7 @@
 #include "Printf/printf.hpp"
 #include "Printf/printf_internal.hpp"
 #include "RNG/deck.hpp"
+#include "RNG/ft_rng.hpp"
 #include "RNG/dice_roll.hpp"
 #include "ReadLine/readline.hpp"
 #include "ReadLine/readline_internal.hpp"
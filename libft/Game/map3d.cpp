@@ -2,9 +2,11 @@
 #include "../CMA/CMA.hpp"
 #include "../CPP_class/nullptr.hpp"
 #include "../Errno/errno.hpp"
+#include <cstdint>
 
 ft_map3d::ft_map3d(size_t width, size_t height, size_t depth, int value)
-    : _data(ft_nullptr), _width(0), _height(0), _depth(0), _error(ER_SUCCESS)
+    : _data(ft_nullptr), _allocation(ft_nullptr), _capacity(0), _width(0),
+      _height(0), _depth(0), _error(ER_SUCCESS)
 {
     this->allocate(width, height, depth, value);
     return ;
@@ -18,7 +20,6 @@ ft_map3d::~ft_map3d()
 
 void ft_map3d::resize(size_t width, size_t height, size_t depth, int value)
 {
-    this->deallocate();
     this->allocate(width, height, depth, value);
     return ;
 }
@@ -40,11 +41,6 @@ void ft_map3d::set_error(int err) const
     return ;
 }
 
-size_t ft_map3d::index(size_t x, size_t y, size_t z) const
-{
-    return (x + y * this->_width + z * this->_width * this->_height);
-}
-
 int ft_map3d::get(size_t x, size_t y, size_t z) const
 {
     if (!this->_data || x >= this->_width || y >= this->_height || z >= this->_depth)
@@ -52,7 +48,7 @@ int ft_map3d::get(size_t x, size_t y, size_t z) const
         const_cast<ft_map3d*>(this)->set_error(MAP3D_OUT_OF_BOUNDS);
         return (0);
     }
-    return (this->_data[z][y][x]);
+    return (this->_data[this->index(x, y, z)]);
 }
 
 void ft_map3d::set(size_t x, size_t y, size_t z, int value)
@@ -62,7 +58,7 @@ void ft_map3d::set(size_t x, size_t y, size_t z, int value)
         this->set_error(MAP3D_OUT_OF_BOUNDS);
         return ;
     }
-    this->_data[z][y][x] = value;
+    this->_data[this->index(x, y, z)] = value;
     return ;
 }
 
@@ -81,64 +77,58 @@ size_t ft_map3d::get_depth() const
     return (this->_depth);
 }
 
+size_t ft_map3d::get_capacity() const
+{
+    return (this->_capacity);
+}
+
 void ft_map3d::allocate(size_t width, size_t height, size_t depth, int value)
 {
     this->_error = ER_SUCCESS;
-    this->_width = width;
-    this->_height = height;
-    this->_depth = depth;
     if (width == 0 || height == 0 || depth == 0)
     {
-        this->_data = ft_nullptr;
+        this->_width = width;
+        this->_height = height;
+        this->_depth = depth;
         return ;
     }
-    this->_data = static_cast<int***>(cma_malloc(sizeof(int**) * depth));
-    if (!this->_data)
+    size_t cells = width * height * depth;
+    if (cells / depth / height != width)
     {
+        this->deallocate();
         this->set_error(MAP3D_ALLOC_FAIL);
         return ;
     }
-    for (size_t z = 0; z < depth; z++)
-        this->_data[z] = ft_nullptr;
-    for (size_t z = 0; z < depth; z++)
+    if (cells > this->_capacity)
     {
-        this->_data[z] = static_cast<int**>(cma_malloc(sizeof(int*) * height));
-        if (!this->_data[z])
+        this->deallocate();
+        void *raw = cma_malloc(sizeof(int) * cells + CACHE_LINE_SIZE - 1);
+        if (!raw)
         {
             this->set_error(MAP3D_ALLOC_FAIL);
-            this->deallocate();
             return ;
         }
-        for (size_t y = 0; y < height; y++)
-            this->_data[z][y] = ft_nullptr;
-        for (size_t y = 0; y < height; y++)
-        {
-            this->_data[z][y] = static_cast<int*>(cma_malloc(sizeof(int) * width));
-            if (!this->_data[z][y])
-            {
-                this->set_error(MAP3D_ALLOC_FAIL);
-                this->deallocate();
-                return ;
-            }
-            for (size_t x = 0; x < width; x++)
-                this->_data[z][y][x] = value;
-        }
+        std::uintptr_t address = reinterpret_cast<std::uintptr_t>(raw);
+        address = (address + CACHE_LINE_SIZE - 1) & ~(static_cast<std::uintptr_t>(CACHE_LINE_SIZE) - 1);
+        this->_allocation = raw;
+        this->_data = reinterpret_cast<int*>(address);
+        this->_capacity = cells;
     }
+    this->_width = width;
+    this->_height = height;
+    this->_depth = depth;
+    for (size_t i = 0; i < cells; i++)
+        this->_data[i] = value;
     return ;
 }
 
 void ft_map3d::deallocate()
 {
-    if (!this->_data)
-        return ;
-    for (size_t z = 0; z < this->_depth; z++)
-    {
-        for (size_t y = 0; y < this->_height; y++)
-            cma_free(this->_data[z][y]);
-        cma_free(this->_data[z]);
-    }
-    cma_free(this->_data);
+    if (this->_allocation)
+        cma_free(this->_allocation);
+    this->_allocation = ft_nullptr;
     this->_data = ft_nullptr;
+    this->_capacity = 0;
     this->_width = 0;
     this->_height = 0;
     this->_depth = 0;
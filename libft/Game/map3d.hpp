@@ -3,10 +3,16 @@
 
 #include <cstddef>
 
+// Cells are stored in one contiguous, cache-line aligned buffer laid out as
+// depth planes of height rows of width ints. The *_unchecked accessors and
+// the row/layer pointers skip bounds checking and must only be used with
+// coordinates the caller has already validated.
 class ft_map3d
 {
     private:
-        int     ***_data;
+        int     *_data;
+        void    *_allocation;
+        size_t  _capacity;
         size_t  _width;
         size_t  _height;
         size_t  _depth;
@@ -20,6 +26,8 @@ class ft_map3d
         size_t  index(size_t x, size_t y, size_t z) const;
 
     public:
+        static const size_t CACHE_LINE_SIZE = 64;
+
         ft_map3d(size_t width = 0, size_t height = 0, size_t depth = 0, int value = 0);
         ~ft_map3d();
 
@@ -32,8 +40,58 @@ class ft_map3d
         size_t  get_width() const;
         size_t  get_height() const;
         size_t  get_depth() const;
+        size_t  get_capacity() const;
         int     get_error() const;
         const char *get_error_str() const;
+
+        int         get_unchecked(size_t x, size_t y, size_t z) const;
+        void        set_unchecked(size_t x, size_t y, size_t z, int value);
+        int         *get_row(size_t y, size_t z);
+        const int   *get_row(size_t y, size_t z) const;
+        int         *get_layer(size_t z);
+        const int   *get_layer(size_t z) const;
+        size_t      get_layer_size() const;
 };
 
+inline __attribute__((always_inline)) size_t ft_map3d::index(size_t x, size_t y, size_t z) const
+{
+    return (x + (y + z * this->_height) * this->_width);
+}
+
+inline __attribute__((always_inline, hot)) int ft_map3d::get_unchecked(size_t x, size_t y, size_t z) const
+{
+    return (this->_data[this->index(x, y, z)]);
+}
+
+inline __attribute__((always_inline, hot)) void ft_map3d::set_unchecked(size_t x, size_t y, size_t z, int value)
+{
+    this->_data[this->index(x, y, z)] = value;
+    return ;
+}
+
+inline __attribute__((always_inline)) int *ft_map3d::get_row(size_t y, size_t z)
+{
+    return (this->_data + this->index(0, y, z));
+}
+
+inline __attribute__((always_inline)) const int *ft_map3d::get_row(size_t y, size_t z) const
+{
+    return (this->_data + this->index(0, y, z));
+}
+
+inline __attribute__((always_inline)) int *ft_map3d::get_layer(size_t z)
+{
+    return (this->_data + this->index(0, 0, z));
+}
+
+inline __attribute__((always_inline)) const int *ft_map3d::get_layer(size_t z) const
+{
+    return (this->_data + this->index(0, 0, z));
+}
+
+inline __attribute__((always_inline)) size_t ft_map3d::get_layer_size() const
+{
+    return (this->_width * this->_height);
+}
+
 #endif
@@ -0,0 +1,83 @@
+#include "ft_rng.hpp"
+#include <chrono>
+#include <climits>
+
+static uint64_t splitmix64(uint64_t &state)
+{
+    state += 0x9E3779B97F4A7C15ULL;
+    uint64_t value = state;
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+    return (value ^ (value >> 31));
+}
+
+ft_rng::ft_rng(uint64_t seed)
+{
+    this->seed(seed);
+    return ;
+}
+
+void ft_rng::seed(uint64_t seed)
+{
+    uint64_t mix = seed;
+    this->_seed = seed;
+    this->_state[0] = splitmix64(mix);
+    this->_state[1] = splitmix64(mix);
+    this->_state[2] = splitmix64(mix);
+    this->_state[3] = splitmix64(mix);
+    return ;
+}
+
+uint64_t ft_rng::get_seed() const
+{
+    return (this->_seed);
+}
+
+int ft_rng::range(int min, int max)
+{
+    if (max <= min)
+        return (min);
+    uint64_t span = static_cast<uint64_t>(static_cast<int64_t>(max) - min) + 1;
+    if (span > UINT32_MAX)
+        return (static_cast<int>(min + static_cast<int64_t>(this->next() % span)));
+    return (static_cast<int>(min + static_cast<int64_t>(
+        this->next_below(static_cast<uint32_t>(span)))));
+}
+
+// Same contract as ft_dice_roll: the sum of number rolls of a faces-sided
+// die, 0 for 0d0 and -1 on invalid input or overflow.
+int ft_rng::dice_roll(int number, int faces)
+{
+    if (faces == 0 && number == 0)
+        return (0);
+    else if (faces < 1 || number < 1)
+        return (-1);
+    else if (faces == 1)
+        return (number);
+    int result = 0;
+    int index = 0;
+    while (index < number)
+    {
+        int roll = static_cast<int>(this->next_below(static_cast<uint32_t>(faces))) + 1;
+        if (result > INT_MAX - roll)
+            return (-1);
+        result += roll;
+        index++;
+    }
+    return (result);
+}
+
+double ft_rng::next_double()
+{
+    return (static_cast<double>(this->next() >> 11) * (1.0 / 9007199254740992.0));
+}
+
+uint64_t ft_rng_entropy_seed(void)
+{
+    static int address_anchor;
+    uint64_t mix = static_cast<uint64_t>(
+        std::chrono::high_resolution_clock::now().time_since_epoch().count());
+    mix ^= static_cast<uint64_t>(reinterpret_cast<uintptr_t>(&address_anchor));
+    mix ^= static_cast<uint64_t>(reinterpret_cast<uintptr_t>(&mix)) << 16;
+    return (splitmix64(mix));
+}
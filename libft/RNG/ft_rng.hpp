@@ -0,0 +1,65 @@
+#ifndef FT_RNG_HPP
+# define FT_RNG_HPP
+
+#include <cstdint>
+
+// Reentrant xoshiro256** generator. Each instance owns its state, so
+// separate instances can be used from separate threads without locking,
+// and a given seed always produces the same sequence.
+class ft_rng
+{
+    private:
+        uint64_t    _state[4];
+        uint64_t    _seed;
+
+    public:
+        explicit ft_rng(uint64_t seed = 0);
+
+        void        seed(uint64_t seed);
+        uint64_t    get_seed() const;
+        uint64_t    next();
+        uint32_t    next_below(uint32_t bound);
+        int         range(int min, int max);
+        int         dice_roll(int number, int faces);
+        double      next_double();
+};
+
+uint64_t    ft_rng_entropy_seed(void);
+
+inline __attribute__((always_inline)) uint64_t ft_rng::next()
+{
+    uint64_t *s = this->_state;
+    uint64_t product = s[1] * 5;
+    uint64_t result = ((product << 7) | (product >> 57)) * 9;
+    uint64_t shifted = s[1] << 17;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= shifted;
+    s[3] = (s[3] << 45) | (s[3] >> 19);
+    return (result);
+}
+
+// Lemire's multiply-and-reject reduction: uniform over [0, bound) without
+// the modulo bias of rand() % bound.
+inline __attribute__((always_inline)) uint32_t ft_rng::next_below(uint32_t bound)
+{
+    if (bound == 0)
+        return (0);
+    uint64_t product = (this->next() >> 32) * bound;
+    uint32_t low = static_cast<uint32_t>(product);
+    if (low < bound)
+    {
+        uint32_t threshold = static_cast<uint32_t>(-bound) % bound;
+        while (low < threshold)
+        {
+            product = (this->next() >> 32) * bound;
+            low = static_cast<uint32_t>(product);
+        }
+    }
+    return (static_cast<uint32_t>(product >> 32));
+}
+
+#endif
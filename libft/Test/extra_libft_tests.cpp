@@ -1,5 +1,6 @@
 #include "../Libft/libft.hpp"
 #include "../CPP_class/nullptr.hpp"
+#include "../RNG/ft_rng.hpp"
 #include <cstring>
 #include <climits>
 #include <string>
@@ -294,3 +295,34 @@ int test_atol_longmin(void)
     return (ft_atol(s.c_str()) == LONG_MIN);
 }
 
+int test_rng_seeded_sequence(void)
+{
+    ft_rng first(1234);
+    ft_rng second(1234);
+    for (int i = 0; i < 100; ++i)
+    {
+        if (first.next() != second.next())
+            return (0);
+    }
+    second.seed(1234);
+    ft_rng third(1234);
+    if (second.next() != third.next() || second.get_seed() != 1234)
+        return (0);
+    int counts[6] = {0, 0, 0, 0, 0, 0};
+    for (int i = 0; i < 6000; ++i)
+    {
+        int roll = first.dice_roll(1, 6);
+        if (roll < 1 || roll > 6)
+            return (0);
+        counts[roll - 1]++;
+    }
+    for (int i = 0; i < 6; ++i)
+    {
+        if (counts[i] < 800 || counts[i] > 1200)
+            return (0);
+    }
+    if (first.range(-3, -3) != -3 || first.dice_roll(0, 0) != 0 || first.dice_roll(1, 0) != -1)
+        return (0);
+    double value = first.next_double();
+    return (value >= 0.0 && value < 1.0);
+}
@@ -10,6 +10,7 @@
 #include "../Game/event.hpp"
 #include "../Game/inventory.hpp"
 #include "../Errno/errno.hpp"
+#include <cstdint>
 
 int test_game_simulation(void)
 {
@@ -292,3 +293,30 @@ int test_quest_progress(void)
     q.advance_phase();
     return (q.get_current_phase() == 3);
 }
+
+int test_map3d_flat_storage(void)
+{
+    ft_map3d grid(4, 3, 2, 7);
+    const int *layer = grid.get_layer(1);
+    if (reinterpret_cast<std::uintptr_t>(grid.get_layer(0)) % ft_map3d::CACHE_LINE_SIZE != 0)
+        return 0;
+    if (layer != grid.get_layer(0) + grid.get_layer_size())
+        return 0;
+    grid.set(2, 1, 1, 5);
+    if (grid.get_unchecked(2, 1, 1) != 5 || grid.get_row(1, 1)[2] != 5)
+        return 0;
+    grid.set_unchecked(3, 2, 0, 9);
+    if (grid.get(3, 2, 0) != 9)
+        return 0;
+    grid.get(4, 0, 0);
+    if (grid.get_error() != MAP3D_OUT_OF_BOUNDS)
+        return 0;
+    size_t capacity = grid.get_capacity();
+    const int *before = grid.get_layer(0);
+    grid.resize(3, 3, 2, 1);
+    if (grid.get_error() != ER_SUCCESS || grid.get_capacity() != capacity
+        || grid.get_layer(0) != before || grid.get(2, 2, 1) != 1)
+        return 0;
+    grid.resize(8, 8, 3, 0);
+    return (grid.get_capacity() >= 8 * 8 * 3 && grid.get(7, 7, 2) == 0);
+}
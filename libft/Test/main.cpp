@@ -141,6 +141,8 @@ int test_item_stack_subtract(void);
 int test_reputation_subtracters(void);
 int test_character_level(void);
 int test_quest_progress(void);
+int test_map3d_flat_storage(void);
+int test_rng_seeded_sequence(void);
 
 int main(void)
 {
@@ -258,7 +260,9 @@ int main(void)
         { test_item_stack_subtract, "item stack subtract" },
         { test_reputation_subtracters, "reputation subtracters" },
         { test_character_level, "character level" },
-        { test_quest_progress, "quest progress" }
+        { test_quest_progress, "quest progress" },
+        { test_map3d_flat_storage, "map3d flat storage" },
+        { test_rng_seeded_sequence, "rng seeded sequence" }
     };
     const int total = sizeof(tests) / sizeof(tests[0]);
 
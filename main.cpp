@@ -7,8 +7,13 @@
 #include <filesystem>
 #include <cctype>
 
+#include "replay_log.hpp"
+
 // Function prototypes
 int parseArguments(int argc, char** argv, int& width, int& height, std::string &bonusMap);
+int extractSessionOptions(int& argc, char** argv, std::string& recordPath,
+                          std::string& replayPath, bool& replayRender, bool& threadedSimulation);
+int runHeadlessReplay(const std::string& path);
 void printUsage(const char* programName);
 int selectGraphicsLibrary();
 
@@ -16,8 +21,25 @@ int selectGraphicsLibrary();
 int main(int argc, char** argv) {
     int width = 30, height = 30; // defaults
     std::string bonusMap;
+    std::string recordPath;
+    std::string replayPath;
+    bool replayRender = false;
+    bool threadedSimulation = false;
 
-    if (parseArguments(argc, argv, width, height, bonusMap) != 0) {
+    if (extractSessionOptions(argc, argv, recordPath, replayPath, replayRender, threadedSimulation) != 0) {
+        return 1;
+    }
+    if (!replayPath.empty()) {
+        if (!replayRender)
+            return runHeadlessReplay(replayPath);
+        replay_log log;
+        if (replay_load(replayPath.c_str(), log) != 0) {
+            print_error("Error: Cannot read replay log '" + replayPath + "'");
+            return 1;
+        }
+        width = log.header.width;
+        height = log.header.height;
+    } else if (parseArguments(argc, argv, width, height, bonusMap) != 0) {
         return 1;
     }
 
@@ -40,6 +62,9 @@ int main(int argc, char** argv) {
         }
     }
 
+    engine.setRecordPath(recordPath);
+    engine.setThreadedSimulation(threadedSimulation);
+
     int initResult = engine.initialize(selectedLibrary);
     if (initResult != 0) {
         const char* error = engine.getError();
@@ -50,6 +75,13 @@ int main(int argc, char** argv) {
         return 1;
     }
 
+    if (!replayPath.empty()) {
+        int replayResult = engine.runReplay(replayPath.c_str());
+        if (engine.getError())
+            print_error(std::string("Error: ") + engine.getError());
+        return replayResult;
+    }
+
     // Run the game
     engine.run();
 
@@ -93,6 +125,61 @@ static bool validateBonusFile(const std::string &path) {
     return true;
 }
 
+// Removes --record <file>, --replay <file>, --render and --threaded from
+// argv so the remaining arguments can go through parseArguments unchanged.
+int extractSessionOptions(int& argc, char** argv, std::string& recordPath,
+                          std::string& replayPath, bool& replayRender, bool& threadedSimulation) {
+    int kept = 1;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--record" || arg == "--replay") {
+            if (i + 1 >= argc) {
+                print_error("Error: " + arg + " requires a file path");
+                return 1;
+            }
+            if (arg == "--record")
+                recordPath = argv[i + 1];
+            else
+                replayPath = argv[i + 1];
+            ++i;
+            continue;
+        }
+        if (arg == "--render") {
+            replayRender = true;
+            continue;
+        }
+        if (arg == "--threaded") {
+            threadedSimulation = true;
+            continue;
+        }
+        argv[kept++] = argv[i];
+    }
+    argc = kept;
+    if (!recordPath.empty() && !replayPath.empty()) {
+        print_error("Error: --record and --replay cannot be combined");
+        return 1;
+    }
+    if (replayRender && replayPath.empty()) {
+        print_error("Error: --render is only valid with --replay");
+        return 1;
+    }
+    return 0;
+}
+
+int runHeadlessReplay(const std::string& path) {
+    replay_report report;
+    if (replay_run_headless(path.c_str(), report) != 0) {
+        print_error("Error: Cannot replay '" + path + "'");
+        return 1;
+    }
+    std::cout << "ticks:        " << report.ticks << std::endl;
+    std::cout << "elapsed:      " << report.elapsed_seconds << " s" << std::endl;
+    std::cout << "ticks/second: " << static_cast<uint64_t>(report.ticks_per_second) << std::endl;
+    std::cout << "game over:    " << (report.game_over ? "yes" : "no") << std::endl;
+    std::cout << "final board:  " << (report.desync ? "DIFFERS from the recording" : "matches the recording") << std::endl;
+    return report.desync ? 1 : 0;
+}
+
 int parseArguments(int argc, char** argv, int& width, int& height, std::string &bonusMap) {
     // Modes:
     // 1) ./nibbler <width> <height>
@@ -129,6 +216,11 @@ int parseArguments(int argc, char** argv, int& width, int& height, std::string &
 void printUsage(const char* programName) {
     std::cout << "Usage: " << programName << " <width> <height>" << std::endl;
     std::cout << "   or:  " << programName << " -b <gamemodefile.nib>" << std::endl;
+    std::cout << "   or:  " << programName << " --replay <log> [--render]" << std::endl;
+    std::cout << "  --record <log> may be added to record each game to a replay log;" << std::endl;
+    std::cout << "    the first game goes to <log>, later ones to <log>-2, <log>-3... before the extension"
+              << std::endl;
+    std::cout << "  --threaded runs the simulation on its own thread, apart from rendering" << std::endl;
     std::cout << "Notes for -b mode:" << std::endl;
     std::cout << "  * File must exist, be readable, regular, and end with .nib" << std::endl;
     std::cout << "  width:  Game area width (10-30)" << std::endl;
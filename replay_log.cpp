@@ -0,0 +1,531 @@
+#include "replay_log.hpp"
+#include "game_data.hpp"
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <iterator>
+
+namespace
+{
+const char REPLAY_MAGIC[8] = {'N', 'I', 'B', 'R', 'P', 'L', 'Y', '1'};
+
+void write_u8(std::ofstream &out, uint8_t value)
+{
+    out.put(static_cast<char>(value));
+}
+
+void write_u32(std::ofstream &out, uint32_t value)
+{
+    for (int shift = 0; shift < 32; shift += 8)
+        write_u8(out, static_cast<uint8_t>(value >> shift));
+}
+
+void write_u64(std::ofstream &out, uint64_t value)
+{
+    for (int shift = 0; shift < 64; shift += 8)
+        write_u8(out, static_cast<uint8_t>(value >> shift));
+}
+
+void write_i32(std::ofstream &out, int32_t value)
+{
+    write_u32(out, static_cast<uint32_t>(value));
+}
+
+void write_f64(std::ofstream &out, double value)
+{
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    write_u64(out, bits);
+}
+
+void write_varint(std::ofstream &out, uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        write_u8(out, static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    write_u8(out, static_cast<uint8_t>(value));
+}
+
+bool same_bits(double a, double b)
+{
+    return (std::memcmp(&a, &b, sizeof(double)) == 0);
+}
+
+struct byte_reader {
+    const std::vector<uint8_t> &bytes;
+    size_t                      offset;
+    bool                        failed;
+
+    uint8_t u8()
+    {
+        if (this->offset >= this->bytes.size())
+        {
+            this->failed = true;
+            return (0);
+        }
+        return (this->bytes[this->offset++]);
+    }
+
+    uint32_t u32()
+    {
+        uint32_t value = 0;
+        for (int shift = 0; shift < 32; shift += 8)
+            value |= static_cast<uint32_t>(this->u8()) << shift;
+        return (value);
+    }
+
+    uint64_t u64()
+    {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 8)
+            value |= static_cast<uint64_t>(this->u8()) << shift;
+        return (value);
+    }
+
+    int32_t i32()
+    {
+        return (static_cast<int32_t>(this->u32()));
+    }
+
+    double f64()
+    {
+        uint64_t bits = this->u64();
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return (value);
+    }
+
+    uint64_t varint()
+    {
+        uint64_t value = 0;
+        int shift = 0;
+        while (shift < 64)
+        {
+            uint8_t byte = this->u8();
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80))
+                return (value);
+            shift += 7;
+        }
+        this->failed = true;
+        return (0);
+    }
+};
+
+void write_header(std::ofstream &out, const replay_header &header)
+{
+    out.write(REPLAY_MAGIC, sizeof(REPLAY_MAGIC));
+    write_u64(out, header.seed);
+    write_i32(out, header.width);
+    write_i32(out, header.height);
+    write_i32(out, header.wrap_around_edges);
+    write_i32(out, header.additional_food_items);
+    write_i32(out, header.simultaneous_moves);
+    write_f64(out, header.moves_per_second);
+    for (int player = 0; player < 4; ++player)
+    {
+        write_i32(out, header.snake_length[player]);
+        write_i32(out, header.direction[player]);
+    }
+    out.write(reinterpret_cast<const char *>(header.terrain.data()),
+              static_cast<std::streamsize>(header.terrain.size()));
+    write_u32(out, static_cast<uint32_t>(header.entities.size()));
+    for (const std::pair<uint32_t, int32_t> &entity : header.entities)
+    {
+        write_u32(out, entity.first);
+        write_i32(out, entity.second);
+    }
+}
+
+int read_header(byte_reader &reader, replay_header &header)
+{
+    for (size_t i = 0; i < sizeof(REPLAY_MAGIC); ++i)
+    {
+        if (static_cast<char>(reader.u8()) != REPLAY_MAGIC[i])
+            return (1);
+    }
+    header.seed = reader.u64();
+    header.width = reader.i32();
+    header.height = reader.i32();
+    header.wrap_around_edges = reader.i32();
+    header.additional_food_items = reader.i32();
+    header.simultaneous_moves = reader.i32();
+    header.moves_per_second = reader.f64();
+    for (int player = 0; player < 4; ++player)
+    {
+        header.snake_length[player] = reader.i32();
+        header.direction[player] = reader.i32();
+    }
+    if (reader.failed || header.width <= 0 || header.height <= 0)
+        return (1);
+    size_t cells = static_cast<size_t>(header.width) * static_cast<size_t>(header.height);
+    if (cells > reader.bytes.size() - reader.offset)
+        return (1);
+    header.terrain.assign(reader.bytes.begin() + static_cast<std::ptrdiff_t>(reader.offset),
+                          reader.bytes.begin() + static_cast<std::ptrdiff_t>(reader.offset + cells));
+    reader.offset += cells;
+    uint32_t entity_count = reader.u32();
+    if (entity_count > cells)
+        return (1);
+    header.entities.clear();
+    header.entities.reserve(entity_count);
+    for (uint32_t i = 0; i < entity_count && !reader.failed; ++i)
+    {
+        uint32_t cell = reader.u32();
+        int32_t value = reader.i32();
+        if (cell >= cells)
+            return (1);
+        header.entities.emplace_back(cell, value);
+    }
+    return (reader.failed ? 1 : 0);
+}
+}
+
+uint64_t replay_board_checksum(const game_data &data)
+{
+    // FNV-1a over both public layers and the snake lengths
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    auto mix = [&hash](uint32_t value) {
+        for (int shift = 0; shift < 32; shift += 8)
+        {
+            hash ^= static_cast<uint8_t>(value >> shift);
+            hash *= 0x100000001B3ULL;
+        }
+    };
+    int width = static_cast<int>(data.get_width());
+    int height = static_cast<int>(data.get_height());
+    mix(static_cast<uint32_t>(width));
+    mix(static_cast<uint32_t>(height));
+    for (int y = 0; y < height; ++y)
+    {
+        for (int x = 0; x < width; ++x)
+        {
+            mix(static_cast<uint32_t>(data.get_map_value(x, y, 0)));
+            mix(static_cast<uint32_t>(data.get_map_value(x, y, 2)));
+        }
+    }
+    for (int player = 0; player < 4; ++player)
+        mix(static_cast<uint32_t>(data.get_snake_length(player)));
+    return (hash);
+}
+
+void replay_capture_header(game_data &data, replay_header &header)
+{
+    header.seed = data.get_rng_seed();
+    header.width = static_cast<int>(data.get_width());
+    header.height = static_cast<int>(data.get_height());
+    header.wrap_around_edges = data.get_wrap_around_edges();
+    header.additional_food_items = data.get_additional_food_items();
+    header.simultaneous_moves = data.get_simultaneous_moves();
+    header.moves_per_second = data.get_moves_per_second();
+    for (int player = 0; player < 4; ++player)
+    {
+        header.snake_length[player] = data.get_snake_length(player);
+        header.direction[player] = data.get_direction_moving(player);
+    }
+    header.terrain.clear();
+    header.entities.clear();
+    uint32_t cell = 0;
+    for (int y = 0; y < header.height; ++y)
+    {
+        for (int x = 0; x < header.width; ++x)
+        {
+            header.terrain.push_back(static_cast<uint8_t>(data.get_map_value(x, y, 0)));
+            int entity = data.get_map_value(x, y, 2);
+            if (entity != 0)
+                header.entities.emplace_back(cell, entity);
+            ++cell;
+        }
+    }
+}
+
+// Rebuilds the recorded starting state. The empty-cell list is rebuilt in
+// its canonical order on both sides, so food placement picks the same cells
+// as in the recorded session.
+int replay_apply_header(const replay_header &header, game_data &data)
+{
+    data.resize_board(header.width, header.height);
+    if (data.get_error() || static_cast<int>(data.get_width()) != header.width ||
+        static_cast<int>(data.get_height()) != header.height)
+        return (1);
+    data.set_wrap_around_edges(header.wrap_around_edges);
+    data.set_additional_food_items(header.additional_food_items);
+    data.set_simultaneous_moves(header.simultaneous_moves);
+    data.set_moves_per_second(header.moves_per_second);
+    size_t cell = 0;
+    for (int y = 0; y < header.height; ++y)
+    {
+        for (int x = 0; x < header.width; ++x)
+        {
+            data.set_map_value(x, y, 2, 0);
+            data.set_map_value(x, y, 0, header.terrain[cell]);
+            ++cell;
+        }
+    }
+    for (const std::pair<uint32_t, int32_t> &entity : header.entities)
+    {
+        int x = static_cast<int>(entity.first % static_cast<uint32_t>(header.width));
+        int y = static_cast<int>(entity.first / static_cast<uint32_t>(header.width));
+        data.set_map_value(x, y, 2, entity.second);
+    }
+    for (int player = 0; player < 4; ++player)
+    {
+        data.reset_player_status_effects(player);
+        data.set_player_snake_length(player, header.snake_length[player]);
+    }
+    data.sync_snake_segments_from_map();
+    data.rebuild_empty_cells();
+    for (int player = 0; player < 4; ++player)
+        data.set_direction_moving(player, header.direction[player]);
+    data.set_rng_seed(header.seed);
+    return (0);
+}
+
+std::string replay_game_path(const std::string &path, int game)
+{
+    if (game <= 1)
+        return (path);
+    std::filesystem::path file(path);
+    std::string name = file.stem().string() + "-" + std::to_string(game) + file.extension().string();
+    return (file.replace_filename(name).string());
+}
+
+int replay_load(const char *path, replay_log &log)
+{
+    if (!path)
+        return (1);
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open())
+        return (1);
+    std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(in)),
+                               std::istreambuf_iterator<char>());
+    byte_reader reader = {bytes, 0, false};
+    if (read_header(reader, log.header) != 0)
+        return (1);
+    log.events.clear();
+    uint64_t tick = 0;
+    while (!reader.failed)
+    {
+        replay_event event;
+        event.type = reader.u8();
+        tick += reader.varint();
+        event.tick = tick;
+        event.player = 0;
+        event.direction = DIRECTION_NONE;
+        event.delta_time = 0.0;
+        event.checksum = 0;
+        if (event.type == REPLAY_EVENT_DIRECTION || event.type == REPLAY_EVENT_TURN)
+        {
+            event.player = reader.u8();
+            event.direction = static_cast<int>(reader.u8()) - 1;
+            if (event.player >= 4)
+                return (1);
+        }
+        else if (event.type == REPLAY_EVENT_STEP)
+            event.delta_time = reader.f64();
+        else if (event.type == REPLAY_EVENT_END)
+            event.checksum = reader.u64();
+        else
+            return (1);
+        if (reader.failed)
+            return (1);
+        log.events.push_back(event);
+        if (event.type == REPLAY_EVENT_END)
+            return (0);
+    }
+    return (1);
+}
+
+replay_recorder::replay_recorder()
+    : _recording(false), _tick(0), _last_event_tick(0), _last_delta(0.0), _has_delta(false)
+{
+    return ;
+}
+
+replay_recorder::~replay_recorder()
+{
+    if (this->_out.is_open())
+        this->_out.close();
+    return ;
+}
+
+// Starts a new log from the current board. The game's RNG is reseeded so
+// the seed written to the header is the one that drives the session.
+int replay_recorder::begin(game_data &data, const char *path)
+{
+    if (this->_out.is_open())
+        this->_out.close();
+    this->_recording = false;
+    if (!path)
+        return (1);
+    this->_out.open(path, std::ios::binary | std::ios::trunc);
+    if (!this->_out.is_open())
+        return (1);
+    data.rebuild_empty_cells();
+    data.set_rng_seed(ft_rng_entropy_seed());
+    replay_header header;
+    replay_capture_header(data, header);
+    write_header(this->_out, header);
+    this->_tick = 0;
+    this->_last_event_tick = 0;
+    this->_has_delta = false;
+    this->_recording = this->_out.good();
+    return (this->_recording ? 0 : 1);
+}
+
+void replay_recorder::write_event_prefix(int type)
+{
+    write_u8(this->_out, static_cast<uint8_t>(type));
+    write_varint(this->_out, this->_tick - this->_last_event_tick);
+    this->_last_event_tick = this->_tick;
+}
+
+void replay_recorder::write_direction_event(int type, int player, int direction)
+{
+    if (!this->_recording)
+        return ;
+    this->write_event_prefix(type);
+    write_u8(this->_out, static_cast<uint8_t>(player));
+    write_u8(this->_out, static_cast<uint8_t>(direction + 1));
+}
+
+void replay_recorder::record_direction(int player, int direction)
+{
+    this->write_direction_event(REPLAY_EVENT_DIRECTION, player, direction);
+}
+
+void replay_recorder::record_turn(int player, int direction)
+{
+    this->write_direction_event(REPLAY_EVENT_TURN, player, direction);
+}
+
+// Call once per update_game_map call, before it runs.
+void replay_recorder::record_step(double delta_time)
+{
+    if (!this->_recording)
+        return ;
+    if (!this->_has_delta || !same_bits(delta_time, this->_last_delta))
+    {
+        this->write_event_prefix(REPLAY_EVENT_STEP);
+        write_f64(this->_out, delta_time);
+        this->_last_delta = delta_time;
+        this->_has_delta = true;
+    }
+    ++this->_tick;
+}
+
+int replay_recorder::end(const game_data &data)
+{
+    if (!this->_recording)
+        return (0);
+    this->write_event_prefix(REPLAY_EVENT_END);
+    write_u64(this->_out, replay_board_checksum(data));
+    this->_out.flush();
+    bool ok = this->_out.good();
+    this->_out.close();
+    this->_recording = false;
+    return (ok ? 0 : 1);
+}
+
+bool replay_recorder::is_recording() const
+{
+    return (this->_recording);
+}
+
+replay_player::replay_player(const replay_log &log)
+    : _log(log), _next_event(0), _tick(0), _end_tick(0), _delta(0.0),
+      _finished(false), _desynced(false)
+{
+    if (!log.events.empty())
+        this->_end_tick = log.events.back().tick;
+    return ;
+}
+
+int replay_player::start(game_data &data)
+{
+    this->_next_event = 0;
+    this->_tick = 0;
+    this->_delta = 0.0;
+    this->_finished = false;
+    this->_desynced = false;
+    return (replay_apply_header(this->_log.header, data));
+}
+
+// Runs one recorded tick. Returns 0 after a normal tick, 1 when the tick
+// ended the game, and 2 once the log is exhausted (the final board is then
+// compared against the recorded checksum).
+int replay_player::step(game_data &data)
+{
+    if (this->_finished)
+        return (2);
+    if (this->_tick >= this->_end_tick)
+    {
+        this->_finished = true;
+        const replay_event &end = this->_log.events.back();
+        this->_desynced = (end.checksum != replay_board_checksum(data));
+        return (2);
+    }
+    const std::vector<replay_event> &events = this->_log.events;
+    while (this->_next_event < events.size() && events[this->_next_event].tick == this->_tick &&
+           events[this->_next_event].type != REPLAY_EVENT_END)
+    {
+        const replay_event &event = events[this->_next_event];
+        if (event.type == REPLAY_EVENT_DIRECTION)
+            data.set_direction_moving(event.player, event.direction);
+        else if (event.type == REPLAY_EVENT_TURN)
+            data.queue_direction(event.player, event.direction);
+        else
+            this->_delta = event.delta_time;
+        ++this->_next_event;
+    }
+    int result = data.update_game_map(this->_delta);
+    ++this->_tick;
+    return (result ? 1 : 0);
+}
+
+bool replay_player::finished() const
+{
+    return (this->_finished);
+}
+
+bool replay_player::desynced() const
+{
+    return (this->_desynced);
+}
+
+uint64_t replay_player::get_tick() const
+{
+    return (this->_tick);
+}
+
+int replay_run_headless(const char *path, replay_report &report)
+{
+    report.ticks = 0;
+    report.game_over = 0;
+    report.desync = 0;
+    report.elapsed_seconds = 0.0;
+    report.ticks_per_second = 0.0;
+    replay_log log;
+    if (replay_load(path, log) != 0)
+        return (1);
+    game_data data(log.header.width, log.header.height);
+    replay_player player(log);
+    if (data.get_error() || player.start(data) != 0)
+        return (1);
+    auto start = std::chrono::steady_clock::now();
+    int result = 0;
+    while ((result = player.step(data)) != 2)
+    {
+        if (result == 1)
+            report.game_over = 1;
+    }
+    auto end = std::chrono::steady_clock::now();
+    report.ticks = player.get_tick();
+    report.desync = player.desynced() ? 1 : 0;
+    report.elapsed_seconds = std::chrono::duration<double>(end - start).count();
+    if (report.elapsed_seconds > 0.0)
+        report.ticks_per_second = static_cast<double>(report.ticks) / report.elapsed_seconds;
+    return (0);
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+class game_data;
+
+// Binary session log. The header captures the board, rules and RNG seed at
+// the moment recording starts; the body is a stream of records keyed by
+// simulation tick (one tick per update_game_map call):
+//   DIRECTION  a set_direction_moving call applied before that tick
+//   TURN       a queue_direction call applied before that tick
+//   STEP       the delta time passed to update_game_map from that tick on;
+//              only written when it differs from the previous one
+//   END        total tick count and a checksum of the final board
+#define REPLAY_EVENT_END        0
+#define REPLAY_EVENT_DIRECTION  1
+#define REPLAY_EVENT_STEP       2
+#define REPLAY_EVENT_TURN       3
+
+struct replay_header {
+    uint64_t             seed;
+    int                  width;
+    int                  height;
+    int                  wrap_around_edges;
+    int                  additional_food_items;
+    int                  simultaneous_moves;
+    double               moves_per_second;
+    int                  snake_length[4];
+    int                  direction[4];
+    std::vector<uint8_t> terrain;
+    std::vector<std::pair<uint32_t, int32_t>> entities;
+};
+
+struct replay_event {
+    int      type;
+    uint64_t tick;
+    int      player;
+    int      direction;
+    double   delta_time;
+    uint64_t checksum;
+};
+
+struct replay_log {
+    replay_header             header;
+    std::vector<replay_event> events;
+};
+
+struct replay_report {
+    uint64_t ticks;
+    int      game_over;
+    int      desync;
+    double   elapsed_seconds;
+    double   ticks_per_second;
+};
+
+uint64_t replay_board_checksum(const game_data &data);
+void     replay_capture_header(game_data &data, replay_header &header);
+int      replay_apply_header(const replay_header &header, game_data &data);
+int      replay_load(const char *path, replay_log &log);
+int      replay_run_headless(const char *path, replay_report &report);
+// File for the given game (from 1) of a session recorded to path: path
+// itself for the first, then "-2", "-3"... before the extension.
+std::string replay_game_path(const std::string &path, int game);
+
+class replay_recorder {
+    public:
+        replay_recorder();
+        ~replay_recorder();
+
+        int  begin(game_data &data, const char *path);
+        void record_direction(int player, int direction);
+        void record_turn(int player, int direction);
+        void record_step(double delta_time);
+        int  end(const game_data &data);
+        bool is_recording() const;
+
+    private:
+        std::ofstream _out;
+        bool          _recording;
+        uint64_t      _tick;
+        uint64_t      _last_event_tick;
+        double        _last_delta;
+        bool          _has_delta;
+
+        void write_event_prefix(int type);
+        void write_direction_event(int type, int player, int direction);
+};
+
+// Feeds a loaded log back through update_game_map, one tick per step().
+class replay_player {
+    public:
+        explicit replay_player(const replay_log &log);
+
+        int      start(game_data &data);
+        int      step(game_data &data);
+        bool     finished() const;
+        bool     desynced() const;
+        uint64_t get_tick() const;
+
+    private:
+        const replay_log &_log;
+        size_t            _next_event;
+        uint64_t          _tick;
+        uint64_t          _end_tick;
+        double            _delta;
+        bool              _finished;
+        bool              _desynced;
+};
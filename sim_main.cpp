@@ -0,0 +1,108 @@
+#include "simulation_runner.hpp"
+#include "console_utils.hpp"
+#include <iostream>
+#include <string>
+#include <thread>
+
+static void printSimUsage(const char *programName) {
+    std::cout << "Usage: " << programName << " [options]" << std::endl;
+    std::cout << "  -g <games>      Number of independent games (default 1000)" << std::endl;
+    std::cout << "  -t <ticks>      Ticks simulated per game (default 1000)" << std::endl;
+    std::cout << "  -j <workers>    Worker threads (default: all cores; at most one per core and per game)" << std::endl;
+    std::cout << "  -n <players>    Snakes per game, 1-4 (default 1)" << std::endl;
+    std::cout << "  -W <width>      Board width (default 30)" << std::endl;
+    std::cout << "  -H <height>     Board height (default 30)" << std::endl;
+    std::cout << "  -s <seed>       Seed for each game's input policy and board RNG (default 0)" << std::endl;
+    std::cout << "  -p <policy>     random or greedy (default greedy)" << std::endl;
+    std::cout << "  --wrap          Wrap around board edges" << std::endl;
+    std::cout << "  --simultaneous  Resolve all players' moves simultaneously (needs -n 2 or more)" << std::endl;
+}
+
+static int parseSimArguments(int argc, char **argv, simulation_config &config) {
+    int i = 1;
+    while (i < argc) {
+        std::string arg = argv[i];
+        if (arg == "--wrap") {
+            config.wrap_around_edges = 1;
+            ++i;
+            continue;
+        }
+        if (arg == "--simultaneous") {
+            config.simultaneous_moves = 1;
+            ++i;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            printSimUsage(argv[0]);
+            return 1;
+        }
+        std::string value = argv[i + 1];
+        try {
+            if (arg == "-g")
+                config.games = std::stoi(value);
+            else if (arg == "-t")
+                config.ticks_per_game = std::stol(value);
+            else if (arg == "-j")
+                config.workers = std::stoi(value);
+            else if (arg == "-n")
+                config.players = std::stoi(value);
+            else if (arg == "-W")
+                config.width = std::stoi(value);
+            else if (arg == "-H")
+                config.height = std::stoi(value);
+            else if (arg == "-s")
+                config.seed = std::stoull(value);
+            else if (arg == "-p" && value == "random")
+                config.policy = simulation_policy_random;
+            else if (arg == "-p" && value == "greedy")
+                config.policy = simulation_policy_greedy;
+            else {
+                printSimUsage(argv[0]);
+                return 1;
+            }
+        } catch (...) {
+            print_error("Error: Invalid value for " + arg);
+            return 1;
+        }
+        i += 2;
+    }
+    if (config.players < 1 || config.players > 4) {
+        print_error("Error: -n takes 1 to 4 players");
+        return 1;
+    }
+    if (config.simultaneous_moves && config.players < 2) {
+        print_error("Error: --simultaneous needs at least two players (-n 2)");
+        return 1;
+    }
+    // Workers share libft's locked allocator, so more threads than cores
+    // only add contention
+    unsigned int cores = std::thread::hardware_concurrency();
+    if (cores > 0 && config.workers > static_cast<int>(cores)) {
+        print_warning("Warning: " + std::to_string(cores) + " hardware threads available, using -j "
+                      + std::to_string(cores));
+        config.workers = static_cast<int>(cores);
+    }
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    simulation_config config;
+    simulation_default_config(config);
+    if (parseSimArguments(argc, argv, config) != 0)
+        return 1;
+
+    simulation_report report;
+    if (run_simulation(config, report) != 0) {
+        print_error("Error: Simulation failed");
+        return 1;
+    }
+    std::cout << "games:        " << config.games << std::endl;
+    std::cout << "players:      " << config.players << std::endl;
+    std::cout << "workers:      " << report.workers << std::endl;
+    std::cout << "ticks:        " << report.ticks << std::endl;
+    std::cout << "game overs:   " << report.game_overs << std::endl;
+    std::cout << "apples eaten: " << report.apples_eaten << std::endl;
+    std::cout << "elapsed:      " << report.elapsed_seconds << " s" << std::endl;
+    std::cout << "ticks/second: " << static_cast<uint64_t>(report.ticks_per_second) << std::endl;
+    return 0;
+}
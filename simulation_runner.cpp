@@ -0,0 +1,210 @@
+#include "simulation_runner.hpp"
+#include "game_data.hpp"
+#include <chrono>
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace
+{
+struct worker_totals {
+    uint64_t ticks;
+    uint64_t game_overs;
+    uint64_t apples_eaten;
+    int      error;
+};
+
+bool is_safe_target(game_data &data, int x, int y)
+{
+    int width = static_cast<int>(data.get_width());
+    int height = static_cast<int>(data.get_height());
+    if (data.get_wrap_around_edges()) {
+        x = (x + width) % width;
+        y = (y + height) % height;
+    } else if (x < 0 || x >= width || y < 0 || y >= height)
+        return (false);
+    if (data.get_map_value(x, y, 0) == GAME_TILE_WALL)
+        return (false);
+    int entity = data.get_map_value(x, y, 2);
+    return (entity == 0 || entity == FOOD || entity == FIRE_FOOD || entity == FROSTY_FOOD);
+}
+
+bool is_food_target(game_data &data, int x, int y)
+{
+    int width = static_cast<int>(data.get_width());
+    int height = static_cast<int>(data.get_height());
+    x = (x + width) % width;
+    y = (y + height) % height;
+    int entity = data.get_map_value(x, y, 2);
+    return (entity == FOOD || entity == FIRE_FOOD || entity == FROSTY_FOOD);
+}
+
+void run_worker(const simulation_config &config, int worker, worker_totals &totals)
+{
+    totals.ticks = 0;
+    totals.game_overs = 0;
+    totals.apples_eaten = 0;
+    totals.error = 0;
+    // One board per worker, reset in place for each game. Building a
+    // fresh game_data per game allocates, and every allocation goes
+    // through libft's allocator and its global lock.
+    game_data data(config.width, config.height);
+    if (data.get_error())
+    {
+        totals.error = data.get_error();
+        return ;
+    }
+    data.set_wrap_around_edges(config.wrap_around_edges);
+    data.set_simultaneous_moves(config.simultaneous_moves);
+    int game_index = worker;
+    while (game_index < config.games)
+    {
+        // Seeding per game keeps each game's food placement and input
+        // stream independent of how games are spread across workers.
+        ft_rng seeder(config.seed ^ (static_cast<uint64_t>(game_index) << 32));
+        ft_rng input_rng(seeder.next());
+        data.set_rng_seed(seeder.next());
+        data.reset_board(config.players);
+        // The apple count lives in the profile's achievements, which
+        // carry over from the worker's previous games
+        int apples_before = data.get_apples_eaten();
+
+        double step = 1.0 / data.get_moves_per_second();
+        long tick = 0;
+        while (tick < config.ticks_per_game)
+        {
+            int player = 0;
+            while (player < 4)
+            {
+                if (data.get_snake_length(player) > 0)
+                {
+                    int direction = config.policy(data, player, input_rng);
+                    if (direction != DIRECTION_NONE)
+                        data.set_direction_moving(player, direction);
+                }
+                ++player;
+            }
+            if (data.update_game_map(step))
+            {
+                ++totals.game_overs;
+                data.reset_board(config.players);
+            }
+            ++tick;
+        }
+        totals.ticks += static_cast<uint64_t>(config.ticks_per_game);
+        totals.apples_eaten += static_cast<uint64_t>(data.get_apples_eaten() - apples_before);
+        game_index += config.workers;
+    }
+    return ;
+}
+}
+
+void simulation_default_config(simulation_config &config)
+{
+    unsigned int cores = std::thread::hardware_concurrency();
+    config.width = 30;
+    config.height = 30;
+    config.games = 1000;
+    config.ticks_per_game = 1000;
+    config.workers = (cores > 0) ? static_cast<int>(cores) : 1;
+    config.players = 1;
+    config.wrap_around_edges = 0;
+    config.simultaneous_moves = 0;
+    config.seed = 0;
+    config.policy = simulation_policy_greedy;
+    return ;
+}
+
+int simulation_policy_random(game_data &data, int player, ft_rng &rng)
+{
+    uint64_t roll = rng.next();
+    if (data.get_direction_moving(player) != DIRECTION_NONE && (roll & 3) != 0)
+        return (DIRECTION_NONE);
+    return (static_cast<int>((roll >> 8) % 4));
+}
+
+// Steps onto adjacent food when possible, otherwise keeps going straight
+// while that is safe and turns to a random safe neighbour when it is not.
+int simulation_policy_greedy(game_data &data, int player, ft_rng &rng)
+{
+    static const int step_x[4] = {0, 1, 0, -1};
+    static const int step_y[4] = {-1, 0, 1, 0};
+    t_coordinates head = data.get_head_coordinate((player + 1) * 1000000 + 1);
+    int current = data.get_direction_moving(player);
+    int safe[4];
+    int safe_count = 0;
+    int direction = 0;
+    while (direction < 4)
+    {
+        int x = head.x + step_x[direction];
+        int y = head.y + step_y[direction];
+        if (is_safe_target(data, x, y))
+        {
+            if (is_food_target(data, x, y))
+                return (direction);
+            safe[safe_count] = direction;
+            ++safe_count;
+        }
+        ++direction;
+    }
+    int index = 0;
+    while (index < safe_count)
+    {
+        if (safe[index] == current)
+            return (DIRECTION_NONE);
+        ++index;
+    }
+    if (safe_count == 0)
+        return (DIRECTION_NONE);
+    return (safe[rng.next_below(static_cast<uint32_t>(safe_count))]);
+}
+
+int run_simulation(const simulation_config &config, simulation_report &report)
+{
+    report.ticks = 0;
+    report.game_overs = 0;
+    report.apples_eaten = 0;
+    report.elapsed_seconds = 0.0;
+    report.ticks_per_second = 0.0;
+    report.workers = 0;
+    if (config.width <= 0 || config.height <= 0 || config.games < 0 ||
+        config.ticks_per_game < 0 || config.workers <= 0 || !config.policy ||
+        config.players < 1 || config.players > 4 || config.height < config.players)
+        return (1);
+
+    int workers = config.workers;
+    if (config.games < workers)
+        workers = (config.games > 0) ? config.games : 1;
+    simulation_config worker_config = config;
+    worker_config.workers = workers;
+    report.workers = workers;
+    std::vector<worker_totals> totals(static_cast<size_t>(workers));
+    std::vector<std::thread> threads;
+    threads.reserve(static_cast<size_t>(workers));
+
+    auto start = std::chrono::steady_clock::now();
+    int worker = 0;
+    while (worker < workers)
+    {
+        threads.emplace_back(run_worker, std::cref(worker_config), worker,
+                             std::ref(totals[static_cast<size_t>(worker)]));
+        ++worker;
+    }
+    for (std::thread &thread : threads)
+        thread.join();
+    auto end = std::chrono::steady_clock::now();
+
+    int error = 0;
+    for (const worker_totals &total : totals)
+    {
+        report.ticks += total.ticks;
+        report.game_overs += total.game_overs;
+        report.apples_eaten += total.apples_eaten;
+        if (total.error)
+            error = 1;
+    }
+    report.elapsed_seconds = std::chrono::duration<double>(end - start).count();
+    if (report.elapsed_seconds > 0.0)
+        report.ticks_per_second = static_cast<double>(report.ticks) / report.elapsed_seconds;
+    return (error);
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+
+class game_data;
+class ft_rng;
+
+// Chooses the next direction for a player. Returning DIRECTION_NONE keeps
+// the current one. rng is owned by the worker running the game.
+typedef int (*simulation_policy)(game_data &data, int player, ft_rng &rng);
+
+struct simulation_config {
+    int               width;
+    int               height;
+    int               games;
+    long              ticks_per_game;
+    int               workers;
+    // Snakes per game, 1 to 4. Players after the first start on rows
+    // spread over the board, so height must be at least players.
+    int               players;
+    int               wrap_around_edges;
+    // Only meaningful with more than one player
+    int               simultaneous_moves;
+    uint64_t          seed;
+    simulation_policy policy;
+};
+
+struct simulation_report {
+    uint64_t ticks;
+    uint64_t game_overs;
+    uint64_t apples_eaten;
+    double   elapsed_seconds;
+    double   ticks_per_second;
+    // Worker threads actually started; never more than there are games
+    int      workers;
+};
+
+void simulation_default_config(simulation_config &config);
+int  run_simulation(const simulation_config &config, simulation_report &report);
+
+int  simulation_policy_random(game_data &data, int player, ft_rng &rng);
+int  simulation_policy_greedy(game_data &data, int player, ft_rng &rng);